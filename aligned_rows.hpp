@@ -0,0 +1,47 @@
+#pragma once
+#ifndef ALIGNED_ROWS_HPP
+#define ALIGNED_ROWS_HPP
+
+/*
+* fingerprint_collectionbit_matrixõд洢
+* һ64ֽڶĻУÿв0124ֻ8ֵһвԽб߽
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace aligned_rows_detail {
+	using word = std::uint64_t;
+
+	constexpr size_t align_words() noexcept {
+		return 8;/*64ֽ*/
+	}
+
+	/*8ȡ2ݣȡ8ı*/
+	inline size_t stride_of(size_t bits) noexcept {
+		auto _words = std::max<size_t>(1, bits / 64 + (bits % 64 != 0));
+		if (_words > align_words()) {
+			return (_words + align_words() - 1) / align_words() * align_words();
+		}
+		size_t _stride = 1;
+		while (_stride < _words) {
+			_stride *= 2;
+		}
+		return _stride;
+	}
+
+	inline word* align(word* ptr) noexcept {
+		auto _addr = reinterpret_cast<std::uintptr_t>(ptr);
+		auto _mask = std::uintptr_t(align_words() * sizeof(word) - 1);
+		return reinterpret_cast<word*>((_addr + _mask) & ~_mask);
+	}
+
+	/*words֣rawжĻжʼλ*/
+	inline word* allocate(std::unique_ptr<word[]>& raw, size_t words) {
+		raw.reset(new word[words + align_words()]());
+		return align(raw.get());
+	}
+}
+
+#endif // !ALIGNED_ROWS_HPP
@@ -0,0 +1,759 @@
+/*
+* dynamic_bitset ׼ԣԱstd::bitsetstd::vector<bool>uint64_t
+* ÷dynamic_bitset_bench [--format=csv|json] [--max-bits=N] [--min-time=] [--filter=Ӵ]
+*/
+
+#include "bit_matrix.hpp"
+#include "bit_stream.hpp"
+#include "blocked_bloom_filter.hpp"
+#include "counted_dynamic_bitset.hpp"
+#include "dynamic_bitset.hpp"
+#include "fingerprint_collection.hpp"
+#include "fixed_dynamic_bitset.hpp"
+#include "segmented_dynamic_bitset.hpp"
+#include "shared_dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+	/*ֹŻ*/
+	template<class T>
+	inline void do_not_optimize(T&& val) {
+#if defined __GNUC__ || defined __clang__
+		asm volatile("" : : "r,m"(val) : "memory");
+#else
+		static volatile char _sink;
+		_sink = *reinterpret_cast<volatile const char*>(&val);
+#endif
+	}
+
+	struct options {
+		bool json = false;
+		size_t max_bits = 1000000000;
+		double min_time = 0.2;
+		std::string filter;
+	};
+
+	struct result {
+		std::string impl;
+		std::string op;
+		size_t bits;
+		size_t iters;
+		double ns_per_op;
+	};
+
+	options opt;
+	std::vector<result> results;
+
+	/*ѭֱִܺʱmin_timeߴִһ*/
+	void run(const char* impl, const char* op, size_t bits, const std::function<void()>& fn) {
+		std::string _name = std::string(impl) + "/" + op;
+		if (!opt.filter.empty() && _name.find(opt.filter) == std::string::npos)
+			return;
+		using clock = std::chrono::steady_clock;
+		size_t _batch = 1;
+		size_t _iters = 0;
+		double _elapsed = 0;
+		while (_elapsed < opt.min_time) {
+			auto _start = clock::now();
+			for (size_t i = 0; i < _batch; ++i) {
+				fn();
+			}
+			_elapsed += std::chrono::duration<double>(clock::now() - _start).count();
+			_iters += _batch;
+			if (_batch < (size_t(1) << 30))
+				_batch *= 2;
+		}
+		results.push_back({ impl, op, bits, _iters, _elapsed * 1e9 / _iters });
+		std::fprintf(stderr, "%-28s %12zu bits %14.1f ns\n", _name.c_str(), bits, _elapsed * 1e9 / _iters);
+	}
+
+	std::string random_string(size_t bits, std::uint64_t seed) {
+		std::mt19937_64 _rng(seed);
+		std::string _res(bits, '0');
+		for (size_t i = 0; i < bits; i += 64) {
+			auto _word = _rng();
+			for (size_t j = i; j < bits && j < i + 64; ++j) {
+				_res[j] = '0' + char(_word >> (j - i) & 1);
+			}
+		}
+		return _res;
+	}
+
+	void bench_dynamic_bitset(size_t bits, const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "dynamic_bitset";
+		run(_impl, "construct_string", bits, [&] {
+			dynamic_bitset _res(str_a);
+			do_not_optimize(_res);
+			});
+		run(_impl, "construct_resize", bits, [&] {
+			dynamic_bitset _res;
+			_res.resize(bits);
+			do_not_optimize(_res);
+			});
+		run(_impl, "push_back", bits, [&] {
+			dynamic_bitset _res;
+			for (size_t i = 0; i < bits; ++i) {
+				_res.push_back(str_a[i] == '1');
+			}
+			do_not_optimize(_res);
+			});
+
+		dynamic_bitset _a(str_a), _b(str_b);
+		run(_impl, "and", bits, [&] { auto _res = _a & _b; do_not_optimize(_res); });
+		run(_impl, "or", bits, [&] { auto _res = _a | _b; do_not_optimize(_res); });
+		run(_impl, "xor", bits, [&] { auto _res = _a ^ _b; do_not_optimize(_res); });
+		run(_impl, "not", bits, [&] { auto _res = ~_a; do_not_optimize(_res); });
+		run(_impl, "shift_left", bits, [&] { auto _res = _a << 13; do_not_optimize(_res); });
+		run(_impl, "shift_right", bits, [&] { auto _res = _a >> 13; do_not_optimize(_res); });
+		run(_impl, "insert_erase_middle", bits, [&] {
+			_a.insert(bits / 2, 13, true);
+			_a.erase(bits / 2, bits / 2 + 13);
+			do_not_optimize(_a);
+			});
+		run(_impl, "iterate", bits, [&] {
+			size_t _count = 0;
+			for (const auto& bit : _a) {
+				_count += bool(bit);
+			}
+			do_not_optimize(_count);
+			});
+		run(_impl, "to_string", bits, [&] { auto _res = _a.to_string(); do_not_optimize(_res); });
+		run(_impl, "count", bits, [&] { auto _res = _a.count(); do_not_optimize(_res); });
+		/*_sub_aӼɨ赽ĩβд(a & b) == aԱ*/
+		auto _sub = _a & _b;
+		run(_impl, "is_subset_of", bits, [&] { auto _res = _sub.is_subset_of(_a); do_not_optimize(_res); });
+		run(_impl, "is_subset_of_via_and", bits, [&] { auto _res = (_sub & _a) == _sub; do_not_optimize(_res); });
+		run(_impl, "intersection_count", bits, [&] { auto _res = intersection_count(_a, _b); do_not_optimize(_res); });
+		run(_impl, "copy", bits, [&] { auto _res(_a); do_not_optimize(_res); });
+		run(_impl, "move", bits, [&] {
+			auto _res(std::move(_a));
+			do_not_optimize(_res);
+			_a = std::move(_res);
+			});
+	}
+
+	/*8·ֵԱȣȡ_a_bĿ*/
+	void bench_n_way(size_t bits, const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "dynamic_bitset";
+		if (bits > 100000000)
+			return;
+		std::vector<dynamic_bitset> _inputs;
+		for (size_t i = 0; i < 8; ++i) {
+			_inputs.emplace_back(i % 2 == 0 ? str_a : str_b);
+		}
+		std::vector<const dynamic_bitset*> _ptrs;
+		for (const auto& _elem : _inputs) {
+			_ptrs.push_back(&_elem);
+		}
+		dynamic_bitset _res;
+		run(_impl, "intersect_all_8", bits, [&] {
+			dynamic_bitset::intersect_all(_res, _ptrs.data(), _ptrs.size());
+			do_not_optimize(_res);
+			});
+		run(_impl, "intersect_pairwise_8", bits, [&] {
+			auto _acc = _inputs[0];
+			for (size_t i = 1; i < _inputs.size(); ++i) {
+				_acc = _acc & _inputs[i];
+			}
+			do_not_optimize(_acc);
+			});
+		run(_impl, "union_all_8", bits, [&] {
+			dynamic_bitset::union_all(_res, _ptrs.data(), _ptrs.size());
+			do_not_optimize(_res);
+			});
+		run(_impl, "threshold_3_of_8", bits, [&] {
+			dynamic_bitset::threshold(_res, 3, _ptrs.data(), _ptrs.size());
+			do_not_optimize(_res);
+			});
+	}
+
+	/*дʱƣֻüһдʱŸ*/
+	void bench_shared_dynamic_bitset(size_t bits, const std::string& str_a) {
+		const char* _impl = "shared_dynamic_bitset";
+		shared_dynamic_bitset _a(str_a);
+		run(_impl, "copy", bits, [&] { auto _res(_a); do_not_optimize(_res); });
+		run(_impl, "copy_then_write", bits, [&] {
+			auto _res(_a);
+			_res[0] = true;
+			do_not_optimize(_res);
+			});
+	}
+
+	template<size_t N>
+	void bench_std_bitset(const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "std::bitset";
+		using bitset = std::bitset<N>;
+		run(_impl, "construct_string", N, [&] {
+			auto _res = std::make_unique<bitset>(str_a);
+			do_not_optimize(*_res);
+			});
+		run(_impl, "construct_resize", N, [&] {
+			auto _res = std::make_unique<bitset>();
+			do_not_optimize(*_res);
+			});
+
+		auto _a = std::make_unique<bitset>(str_a);
+		auto _b = std::make_unique<bitset>(str_b);
+		auto _res = std::make_unique<bitset>();
+		run(_impl, "and", N, [&] { *_res = *_a & *_b; do_not_optimize(*_res); });
+		run(_impl, "or", N, [&] { *_res = *_a | *_b; do_not_optimize(*_res); });
+		run(_impl, "xor", N, [&] { *_res = *_a ^ *_b; do_not_optimize(*_res); });
+		run(_impl, "not", N, [&] { *_res = ~*_a; do_not_optimize(*_res); });
+		run(_impl, "shift_left", N, [&] { *_res = *_a << 13; do_not_optimize(*_res); });
+		run(_impl, "shift_right", N, [&] { *_res = *_a >> 13; do_not_optimize(*_res); });
+		run(_impl, "iterate", N, [&] {
+			size_t _count = 0;
+			for (size_t i = 0; i < N; ++i) {
+				_count += _a->test(i);
+			}
+			do_not_optimize(_count);
+			});
+		run(_impl, "to_string", N, [&] { auto _str = _a->to_string(); do_not_optimize(_str); });
+		run(_impl, "copy", N, [&] { *_res = *_a; do_not_optimize(*_res); });
+	}
+
+	template<size_t N>
+	void bench_fixed_dynamic_bitset(const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "fixed_dynamic_bitset";
+		using bitset = fixed_dynamic_bitset<N>;
+		run(_impl, "construct_string", N, [&] {
+			auto _res = std::make_unique<bitset>(str_a);
+			do_not_optimize(*_res);
+			});
+
+		auto _a = std::make_unique<bitset>(str_a);
+		auto _b = std::make_unique<bitset>(str_b);
+		auto _res = std::make_unique<bitset>();
+		run(_impl, "and", N, [&] { *_res = *_a & *_b; do_not_optimize(*_res); });
+		run(_impl, "or", N, [&] { *_res = *_a | *_b; do_not_optimize(*_res); });
+		run(_impl, "xor", N, [&] { *_res = *_a ^ *_b; do_not_optimize(*_res); });
+		run(_impl, "not", N, [&] { *_res = ~*_a; do_not_optimize(*_res); });
+		run(_impl, "shift_left", N, [&] { *_res = *_a << 13; do_not_optimize(*_res); });
+		run(_impl, "shift_right", N, [&] { *_res = *_a >> 13; do_not_optimize(*_res); });
+		run(_impl, "to_string", N, [&] { auto _str = _a->to_string(); do_not_optimize(_str); });
+		run(_impl, "copy", N, [&] { *_res = *_a; do_not_optimize(*_res); });
+	}
+
+	void bench_vector_bool(size_t bits, const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "std::vector<bool>";
+		auto _from_string = [](const std::string& str) {
+			std::vector<bool> _res(str.size());
+			for (size_t i = 0; i < str.size(); ++i) {
+				_res[i] = str[i] == '1';
+			}
+			return _res;
+		};
+		run(_impl, "construct_string", bits, [&] { auto _res = _from_string(str_a); do_not_optimize(_res); });
+		run(_impl, "construct_resize", bits, [&] { std::vector<bool> _res(bits); do_not_optimize(_res); });
+		run(_impl, "push_back", bits, [&] {
+			std::vector<bool> _res;
+			for (size_t i = 0; i < bits; ++i) {
+				_res.push_back(str_a[i] == '1');
+			}
+			do_not_optimize(_res);
+			});
+
+		auto _a = _from_string(str_a), _b = _from_string(str_b);
+		auto _binary = [&](bool(*fn)(bool, bool)) {
+			std::vector<bool> _res(bits);
+			for (size_t i = 0; i < bits; ++i) {
+				_res[i] = fn(_a[i], _b[i]);
+			}
+			return _res;
+		};
+		run(_impl, "and", bits, [&] { auto _res = _binary([](bool l, bool r) { return l && r; }); do_not_optimize(_res); });
+		run(_impl, "or", bits, [&] { auto _res = _binary([](bool l, bool r) { return l || r; }); do_not_optimize(_res); });
+		run(_impl, "xor", bits, [&] { auto _res = _binary([](bool l, bool r) { return l != r; }); do_not_optimize(_res); });
+		run(_impl, "not", bits, [&] { auto _res(_a); _res.flip(); do_not_optimize(_res); });
+		run(_impl, "shift_left", bits, [&] { auto _res(_a); _res.insert(_res.end(), 13, false); do_not_optimize(_res); });
+		run(_impl, "shift_right", bits, [&] { auto _res(_a); _res.insert(_res.begin(), 13, false); do_not_optimize(_res); });
+		run(_impl, "insert_erase_middle", bits, [&] {
+			_a.insert(_a.begin() + bits / 2, 13, true);
+			_a.erase(_a.begin() + bits / 2, _a.begin() + bits / 2 + 13);
+			do_not_optimize(_a);
+			});
+		run(_impl, "iterate", bits, [&] {
+			size_t _count = 0;
+			for (bool bit : _a) {
+				_count += bit;
+			}
+			do_not_optimize(_count);
+			});
+		run(_impl, "to_string", bits, [&] {
+			std::string _str(bits, '0');
+			for (size_t i = 0; i < bits; ++i) {
+				if (_a[i])
+					_str[i] = '1';
+			}
+			do_not_optimize(_str);
+			});
+		run(_impl, "copy", bits, [&] { auto _res(_a); do_not_optimize(_res); });
+		run(_impl, "move", bits, [&] {
+			auto _res(std::move(_a));
+			do_not_optimize(_res);
+			_a = std::move(_res);
+			});
+	}
+
+	/*дuint64_t飬Ϊ޲ο*/
+	void bench_raw_words(size_t bits, const std::string& str_a, const std::string& str_b) {
+		const char* _impl = "uint64_t[]";
+		using words = std::vector<std::uint64_t>;
+		auto _word_count = (bits + 63) / 64;
+		auto _from_string = [&](const std::string& str) {
+			words _res(_word_count);
+			for (size_t i = 0; i < str.size(); ++i) {
+				_res[i / 64] |= std::uint64_t(str[i] == '1') << (i % 64);
+			}
+			return _res;
+		};
+		run(_impl, "construct_string", bits, [&] { auto _res = _from_string(str_a); do_not_optimize(_res); });
+		run(_impl, "construct_resize", bits, [&] { words _res(_word_count); do_not_optimize(_res); });
+		run(_impl, "push_back", bits, [&] {
+			words _res;
+			for (size_t i = 0; i < bits; ++i) {
+				if (i % 64 == 0)
+					_res.push_back(0);
+				_res.back() |= std::uint64_t(str_a[i] == '1') << (i % 64);
+			}
+			do_not_optimize(_res);
+			});
+
+		auto _a = _from_string(str_a), _b = _from_string(str_b);
+		words _res(_word_count);
+		run(_impl, "and", bits, [&] {
+			for (size_t i = 0; i < _word_count; ++i) _res[i] = _a[i] & _b[i];
+			do_not_optimize(_res);
+			});
+		run(_impl, "or", bits, [&] {
+			for (size_t i = 0; i < _word_count; ++i) _res[i] = _a[i] | _b[i];
+			do_not_optimize(_res);
+			});
+		run(_impl, "xor", bits, [&] {
+			for (size_t i = 0; i < _word_count; ++i) _res[i] = _a[i] ^ _b[i];
+			do_not_optimize(_res);
+			});
+		run(_impl, "not", bits, [&] {
+			for (size_t i = 0; i < _word_count; ++i) _res[i] = ~_a[i];
+			do_not_optimize(_res);
+			});
+		run(_impl, "shift_left", bits, [&] {
+			_res[0] = _a[0] << 13;
+			for (size_t i = 1; i < _word_count; ++i) _res[i] = _a[i] << 13 | _a[i - 1] >> 51;
+			do_not_optimize(_res);
+			});
+		run(_impl, "shift_right", bits, [&] {
+			for (size_t i = 0; i + 1 < _word_count; ++i) _res[i] = _a[i] >> 13 | _a[i + 1] << 51;
+			_res[_word_count - 1] = _a[_word_count - 1] >> 13;
+			do_not_optimize(_res);
+			});
+		run(_impl, "iterate", bits, [&] {
+			size_t _count = 0;
+			for (size_t i = 0; i < bits; ++i) {
+				_count += _a[i / 64] >> (i % 64) & 1;
+			}
+			do_not_optimize(_count);
+			});
+		run(_impl, "to_string", bits, [&] {
+			std::string _str(bits, '0');
+			for (size_t i = 0; i < bits; ++i) {
+				_str[i] = '0' + char(_a[i / 64] >> (i % 64) & 1);
+			}
+			do_not_optimize(_str);
+			});
+		run(_impl, "copy", bits, [&] { auto _copy(_a); do_not_optimize(_copy); });
+		run(_impl, "move", bits, [&] {
+			auto _tmp(std::move(_a));
+			do_not_optimize(_tmp);
+			_a = std::move(_tmp);
+			});
+	}
+
+	void bench_size(size_t bits, const std::function<void(const std::string&, const std::string&)>& fixed_size) {
+		if (bits > opt.max_bits)
+			return;
+		auto _str_a = random_string(bits, 1);
+		auto _str_b = random_string(bits, 2);
+		bench_dynamic_bitset(bits, _str_a, _str_b);
+		bench_shared_dynamic_bitset(bits, _str_a);
+		bench_n_way(bits, _str_a, _str_b);
+		fixed_size(_str_a, _str_b);
+		bench_vector_bool(bits, _str_a, _str_b);
+		bench_raw_words(bits, _str_a, _str_b);
+	}
+
+	template<size_t N>
+	void bench_fixed_size(const std::string& str_a, const std::string& str_b) {
+		bench_fixed_dynamic_bitset<N>(str_a, str_b);
+		bench_std_bitset<N>(str_a, str_b);
+	}
+
+	/*std::bitsetfixed_dynamic_bitsetĳȱǱڳ˳ߴչ*/
+	template<size_t... N>
+	void bench_sizes() {
+		int _expand[] = { (bench_size(N, bench_fixed_size<N>), 0)... };
+		(void)_expand;
+	}
+
+	/*ָ룺һԶΪ10^6ָƣall-pairsΪ2*10^4ָ(Լ2*10^8)*/
+	void bench_fingerprints() {
+		const char* _impl = "fingerprint_collection";
+		for (size_t _bits : { 64, 256, 1024 }) {
+			fingerprint_collection _fps(_bits);
+			std::mt19937_64 _rng(_bits);
+			size_t _n = 1000000;
+			_fps.reserve(_n);
+			dynamic_bitset _fp;
+			_fp.resize(_bits);
+			for (size_t i = 0; i < _n; ++i) {
+				for (size_t j = 0; j < _fp.word_count(); ++j) {
+					_fp.set_word(j, _rng());
+				}
+				_fps.push_back(_fp);
+			}
+			std::vector<std::uint32_t> _distances(_n);
+			run(_impl, "hamming_to_all_1e6", _bits, [&] {
+				_fps.hamming_to_all(_fp, _distances.data());
+				do_not_optimize(_distances);
+				});
+			run(_impl, "hamming_to_all_1e6_mt", _bits, [&] {
+				_fps.hamming_to_all(_fp, _distances.data(), 0);
+				do_not_optimize(_distances);
+				});
+			run(_impl, "nearest_hamming_10_of_1e6", _bits, [&] {
+				auto _res = _fps.nearest_hamming(_fp, 10);
+				do_not_optimize(_res);
+				});
+			fingerprint_collection _small(_bits);
+			for (size_t i = 0; i < 20000; ++i) {
+				_small.push_back(_fps[i]);
+			}
+			run(_impl, "pairs_within_hamming_2e4_mt", _bits, [&] {
+				auto _res = _small.pairs_within_hamming(std::uint32_t(_bits / 4));
+				do_not_optimize(_res);
+				});
+		}
+	}
+
+	/*n x nĳ˷ԪתãbitsΪn*/
+	void bench_bit_matrix() {
+		const char* _impl = "bit_matrix";
+		for (size_t _n : { 64, 256, 1024, 4096 }) {
+			std::mt19937_64 _rng(_n);
+			bit_matrix _a(_n, _n), _b(_n, _n);
+			for (size_t i = 0; i < _n; ++i) {
+				for (size_t j = 0; j < _a.stride(); ++j) {
+					_a.row_data(i)[j] = _rng();
+					_b.row_data(i)[j] = _rng();
+				}
+			}
+			run(_impl, "multiply", _n, [&] { auto _res = _a * _b; do_not_optimize(_res); });
+			run(_impl, "eliminate", _n, [&] { auto _res(_a); do_not_optimize(_res.eliminate()); });
+			run(_impl, "transpose", _n, [&] { auto _res = _a.transpose(); do_not_optimize(_res); });
+		}
+	}
+
+	/*ֿBloomdynamic_bitsetoperator[]7̽ͨBloomԱȣbitsΪ*/
+	void bench_bloom_filter() {
+		const char* _impl = "blocked_bloom_filter";
+		for (size_t _n : { 10000, 1000000, 10000000 }) {
+			std::mt19937_64 _rng(_n);
+			std::vector<std::uint64_t> _keys(_n);
+			for (auto& _key : _keys) {
+				_key = _rng();
+			}
+			auto _filter = blocked_bloom_filter::for_capacity(_n, 0.01);
+			run(_impl, "insert_batch", _n, [&] { _filter.insert(_keys.data(), _keys.size()); });
+			std::unique_ptr<bool[]> _found(new bool[_n]);
+			run(_impl, "contains_batch", _n, [&] {
+				_filter.contains(_keys.data(), _keys.size(), _found.get());
+				do_not_optimize(_found[0]);
+				});
+			run(_impl, "contains_single", _n, [&] {
+				size_t _count = 0;
+				for (auto _key : _keys) {
+					_count += _filter.contains(_key);
+				}
+				do_not_optimize(_count);
+				});
+
+			dynamic_bitset _plain;
+			_plain.resize(_filter.size_in_bits());
+			auto _bits = _plain.size();
+			run("dynamic_bitset", "bloom_insert_k7", _n, [&] {
+				for (auto _key : _keys) {
+					for (std::uint64_t i = 0; i < 7; ++i) {
+						_plain[(_key + i * (_key >> 32 | 1)) % _bits] = true;
+					}
+				}
+				});
+			run("dynamic_bitset", "bloom_contains_k7", _n, [&] {
+				size_t _count = 0;
+				for (auto _key : _keys) {
+					bool _all = true;
+					for (std::uint64_t i = 0; i < 7 && _all; ++i) {
+						_all = _plain[(_key + i * (_key >> 32 | 1)) % _bits];
+					}
+					_count += _all;
+				}
+				do_not_optimize(_count);
+				});
+		}
+	}
+
+	/*Elias-gamma룺λpush_backbit_writer/bit_readerԱ*/
+	void bench_bit_stream() {
+		const size_t _n = 100000;
+		std::mt19937_64 _rng(_n);
+		std::vector<std::uint64_t> _values(_n);
+		for (auto& _val : _values) {
+			_val = (_rng() >> (_rng() % 64)) | 1;
+		}
+		dynamic_bitset _encoded;
+		run("dynamic_bitset", "gamma_encode_push_back", _n, [&] {
+			dynamic_bitset _out;
+			for (auto _val : _values) {
+				auto _k = 63 - dynamic_bitset::countl_zero(_val);
+				_out.push_back(size_t(_k), false);
+				_out.push_back(true);
+				for (int i = 0; i < _k; ++i) {
+					_out.push_back((_val >> i) & 1);
+				}
+			}
+			do_not_optimize(_out.size());
+			});
+		run("bit_writer", "gamma_encode", _n, [&] {
+			dynamic_bitset _out;
+			{
+				bit_writer _writer(_out);
+				for (auto _val : _values) {
+					_writer.write_gamma(_val);
+				}
+			}
+			do_not_optimize(_out.size());
+			_encoded.swap(_out);
+			});
+		run("bit_reader", "gamma_decode", _n, [&] {
+			bit_reader _reader(_encoded);
+			std::uint64_t _sum = 0;
+			for (size_t i = 0; i < _n; ++i) {
+				_sum += _reader.read_gamma();
+			}
+			do_not_optimize(_sum);
+			});
+	}
+
+	/*±бתϡ(Լ1/16)(Լ1/2)ܶ*/
+	void bench_indices() {
+		const size_t _bits = std::min<size_t>(10000000, opt.max_bits);
+		for (int _sparse : { 1, 0 }) {
+			std::mt19937_64 _rng(_bits);
+			dynamic_bitset _set;
+			_set.resize(_bits);
+			for (size_t i = 0; i < _set.word_count(); ++i) {
+				_set.set_word(i, _sparse ? _rng() & _rng() & _rng() & _rng() : _rng());
+			}
+			std::string _suffix = _sparse ? "_sparse" : "_dense";
+			std::vector<std::uint32_t> _indices(_set.count());
+			run("dynamic_bitset", ("to_indices_by_bit" + _suffix).c_str(), _bits, [&] {
+				size_t _count = 0;
+				for (size_t i = 0; i < _bits; ++i) {
+					if (_set[i]) {
+						_indices[_count++] = std::uint32_t(i);
+					}
+				}
+				do_not_optimize(_count);
+				});
+			run("dynamic_bitset", ("to_indices" + _suffix).c_str(), _bits, [&] {
+				do_not_optimize(_set.to_indices(_indices.data()));
+				});
+			/*ÿ64Kλ±鲻256KB*/
+			std::vector<std::uint32_t> _chunk(65536);
+			run("dynamic_bitset", ("to_indices_chunked" + _suffix).c_str(), _bits, [&] {
+				size_t _count = 0;
+				for (size_t i = 0; i < _bits; i += _chunk.size()) {
+					_count += _set.to_indices(i, std::min(_bits, i + _chunk.size()), _chunk.data());
+				}
+				do_not_optimize(_count);
+				});
+			run("dynamic_bitset", ("from_indices_by_bit" + _suffix).c_str(), _bits, [&] {
+				dynamic_bitset _res;
+				_res.resize(_bits);
+				for (auto _index : _indices) {
+					_res[_index] = true;
+				}
+				do_not_optimize(_res);
+				});
+			run("dynamic_bitset", ("from_indices" + _suffix).c_str(), _bits, [&] {
+				auto _res = dynamic_bitset::from_indices(_indices.data(), _indices.size(), _bits);
+				do_not_optimize(_res);
+				});
+		}
+	}
+
+	/*ҳӳֵ(2MB)ķͷźͿʱÿmmap/munmapĿ*/
+	void bench_huge_pages() {
+		for (size_t _bits : { size_t(1) << 23, size_t(1) << 24, size_t(1) << 28 }) {
+			if (_bits > opt.max_bits)
+				continue;
+			dynamic_bitset _a;
+			_a.resize(_bits);
+			for (size_t i = 0; i < _bits; i += 4099) {
+				_a[i] = true;
+			}
+			run("dynamic_bitset", "huge_page_alloc_free", _bits, [&] {
+				dynamic_bitset _res;
+				_res.resize(_bits);
+				do_not_optimize(_res);
+				});
+			run("dynamic_bitset", "huge_page_copy", _bits, [&] { auto _res(_a); do_not_optimize(_res); });
+		}
+	}
+
+	/*64KλĿ鲻׷ӣ洢ʱҪȫ*/
+	void bench_segmented() {
+		const size_t _bits = std::min<size_t>(200000000, opt.max_bits);
+		std::mt19937_64 _rng(_bits);
+		dynamic_bitset _block;
+		_block.resize(65536);
+		for (size_t i = 0; i < _block.word_count(); ++i) {
+			_block.set_word(i, _rng());
+		}
+		run("dynamic_bitset", "append_grow", _bits, [&] {
+			dynamic_bitset _res;
+			while (_res.size() < _bits) {
+				_res.push_back(_block);
+			}
+			do_not_optimize(_res);
+			});
+		run("segmented_dynamic_bitset", "append_grow", _bits, [&] {
+			segmented_dynamic_bitset _res;
+			while (_res.size() < _bits) {
+				_res.push_back(_block);
+			}
+			do_not_optimize(_res);
+			});
+		dynamic_bitset _plain;
+		while (_plain.size() < _bits) {
+			_plain.push_back(_block);
+		}
+		segmented_dynamic_bitset _segmented(_plain), _other(_plain >> 13);
+		run("segmented_dynamic_bitset", "count", _bits, [&] { do_not_optimize(_segmented.count()); });
+		run("segmented_dynamic_bitset", "to_dynamic_bitset", _bits, [&] { auto _res = _segmented.to_dynamic_bitset(); do_not_optimize(_res); });
+		run("segmented_dynamic_bitset", "xor_assign", _bits, [&] { _segmented ^= _other; do_not_optimize(_segmented); });
+	}
+
+	/*嵥λдظcount()*/
+	void bench_counted() {
+		for (size_t _bits : { 10000, 1000000, 100000000 }) {
+			if (_bits > opt.max_bits)
+				continue;
+			std::mt19937_64 _rng(_bits);
+			dynamic_bitset _plain;
+			_plain.resize(_bits);
+			for (size_t i = 0; i < _plain.word_count(); ++i) {
+				_plain.set_word(i, _rng());
+			}
+			counted_dynamic_bitset _counted(_plain);
+			size_t _index = 0;
+			run("dynamic_bitset", "set_then_count", _bits, [&] {
+				_index = (_index + 7919) % _bits;
+				_plain[_index] = !_plain[_index];
+				do_not_optimize(_plain.count());
+				});
+			run("counted_dynamic_bitset", "set_then_count", _bits, [&] {
+				_index = (_index + 7919) % _bits;
+				_counted[_index] = !_counted[_index];
+				do_not_optimize(_counted.count());
+				});
+			run("counted_dynamic_bitset", "or_then_count", _bits, [&] {
+				_counted |= _plain;
+				do_not_optimize(_counted.count());
+				});
+		}
+	}
+
+	void print_results() {
+		if (opt.json) {
+			std::printf("[\n");
+			for (size_t i = 0; i < results.size(); ++i) {
+				const auto& _res = results[i];
+				std::printf("  {\"impl\": \"%s\", \"op\": \"%s\", \"bits\": %zu, \"iterations\": %zu, \"ns_per_op\": %.3f}%s\n",
+					_res.impl.c_str(), _res.op.c_str(), _res.bits, _res.iters, _res.ns_per_op,
+					i + 1 == results.size() ? "" : ",");
+			}
+			std::printf("]\n");
+		}
+		else {
+			std::printf("impl,op,bits,iterations,ns_per_op\n");
+			for (const auto& _res : results) {
+				std::printf("%s,%s,%zu,%zu,%.3f\n",
+					_res.impl.c_str(), _res.op.c_str(), _res.bits, _res.iters, _res.ns_per_op);
+			}
+		}
+	}
+
+	bool parse_args(int argc, char** argv) {
+		for (int i = 1; i < argc; ++i) {
+			std::string _arg = argv[i];
+			auto _value = [&](const char* key) -> const char* {
+				auto _len = std::strlen(key);
+				return _arg.compare(0, _len, key) == 0 ? _arg.c_str() + _len : nullptr;
+			};
+			if (auto _val = _value("--format=")) {
+				opt.json = std::string(_val) == "json";
+			}
+			else if (auto _val = _value("--max-bits=")) {
+				opt.max_bits = std::strtoull(_val, nullptr, 10);
+			}
+			else if (auto _val = _value("--min-time=")) {
+				opt.min_time = std::strtod(_val, nullptr);
+			}
+			else if (auto _val = _value("--filter=")) {
+				opt.filter = _val;
+			}
+			else {
+				std::fprintf(stderr, "usage: %s [--format=csv|json] [--max-bits=N] [--min-time=seconds] [--filter=substring]\n", argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (!parse_args(argc, argv))
+		return 1;
+	/*sso߽(112λ)Լӵֵ10^9λĸ*/
+	bench_sizes<1, 8, 63, 64, 65, 111, 112, 113, 128, 1000, 10000, 100000,
+		1000000, 10000000, 100000000, 1000000000>();
+	bench_fingerprints();
+	bench_bit_matrix();
+	bench_bloom_filter();
+	bench_counted();
+	bench_bit_stream();
+	bench_indices();
+	bench_huge_pages();
+	bench_segmented();
+	print_results();
+#if defined DYNAMIC_BITSET_STATS
+	auto _stats = dynamic_bitset_stats::global_snapshot();
+	for (size_t i = 0; i < dynamic_bitset_stats::counter_count; ++i) {
+		auto _counter = dynamic_bitset_stats::counter(i);
+		std::fprintf(stderr, "%-20s %llu\n", dynamic_bitset_stats::name(_counter), (unsigned long long)_stats[_counter]);
+	}
+#endif
+	return 0;
+}
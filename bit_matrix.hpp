@@ -0,0 +1,369 @@
+#pragma once
+#ifndef BIT_MATRIX_HPP
+#define BIT_MATRIX_HPP
+
+/*
+* GF(2)ϵĳܾд洢ʹaligned_rows.hppĲ
+* rеcǸеc / 64ֵĵc % 64λdynamic_bitsetλ˳ͬ
+* ˷ԪʹFour-Russiansÿ8Ԥ256ϣ֮ÿֻһβ
+*/
+
+#include "aligned_rows.hpp"
+#include "dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined DEBUG || defined _DEBUG
+#define NOEXCEPT_RELEASE
+#else
+#define NOEXCEPT_RELEASE noexcept
+#endif
+
+class bit_matrix
+{
+private:
+	using word = std::uint64_t;
+
+	/*Four-Russiansÿδ/*/
+	static constexpr size_t russian_bits() noexcept {
+		return 8;
+	}
+
+	size_t __rows{};
+	size_t __cols{};
+	size_t __stride{};/*ÿе*/
+	std::unique_ptr<word[]> __raw;
+	word* __words{};
+
+	static size_t max_size_of(const std::vector<dynamic_bitset>& rows) noexcept {
+		size_t _max_size = 0;
+		for (const auto& _row : rows) {
+			_max_size = std::max(_max_size, _row.size());
+		}
+		return _max_size;
+	}
+
+	static void xor_words(word* dst, const word* src, size_t first, size_t last) noexcept {
+		for (size_t i = first; i < last; ++i) {
+			dst[i] ^= src[i];
+		}
+	}
+
+	/*64x64λתãblock[i]ĵjλblock[j]ĵiλ*/
+	static void transpose_64(word* block) noexcept {
+		word _mask = 0x00000000ffffffffULL;
+		for (size_t j = 32; j != 0; j >>= 1, _mask ^= _mask << j) {
+			for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+				auto _tmp = ((block[k] >> j) ^ block[k | j]) & _mask;
+				block[k] ^= _tmp << j;
+				block[k | j] ^= _tmp;
+			}
+		}
+	}
+
+	/*table[i] = iĸλѡȡrowsеÿֻһ*/
+	void build_table(std::vector<word>& table, const word* const* rows, size_t count, size_t first_word) const {
+		table.assign((size_t(1) << count) * __stride, 0);
+		for (size_t i = 1; i < (size_t(1) << count); ++i) {
+			auto _dst = table.data() + i * __stride;
+			auto _prev = table.data() + (i & (i - 1)) * __stride;
+			auto _row = rows[dynamic_bitset::countr_zero(i)];
+			for (size_t w = first_word; w < __stride; ++w) {
+				_dst[w] = _prev[w] ^ _row[w];
+			}
+		}
+	}
+
+public:
+	bit_matrix() noexcept {}
+
+	bit_matrix(size_t rows, size_t cols)
+		:__rows(rows), __cols(cols), __stride(aligned_rows_detail::stride_of(cols)) {
+		__words = aligned_rows_detail::allocate(__raw, rows * __stride);
+	}
+
+	/*Ϊrows.size()Ϊһеĳȣ϶̵в0*/
+	explicit bit_matrix(const std::vector<dynamic_bitset>& rows)
+		:bit_matrix(rows.size(), max_size_of(rows)) {
+		for (size_t i = 0; i < __rows; ++i) {
+			set_row(i, rows[i]);
+		}
+	}
+
+	bit_matrix(const bit_matrix& rhs) :bit_matrix(rhs.__rows, rhs.__cols) {
+		if (__rows != 0) {
+			std::memcpy(__words, rhs.__words, __rows * __stride * sizeof(word));
+		}
+	}
+
+	/*rhsΪ0x0*/
+	bit_matrix(bit_matrix&& rhs) noexcept
+		:__rows(std::exchange(rhs.__rows, 0)), __cols(std::exchange(rhs.__cols, 0)),
+		__stride(std::exchange(rhs.__stride, 0)), __raw(std::move(rhs.__raw)),
+		__words(std::exchange(rhs.__words, nullptr)) {}
+
+	bit_matrix& operator=(const bit_matrix& rhs) {
+		auto _tmp(rhs);
+		swap(_tmp);
+		return *this;
+	}
+
+	bit_matrix& operator=(bit_matrix&& rhs) noexcept {
+		bit_matrix _tmp(std::move(rhs));
+		swap(_tmp);
+		return *this;
+	}
+
+	void swap(bit_matrix& rhs) noexcept {
+		std::swap(__rows, rhs.__rows);
+		std::swap(__cols, rhs.__cols);
+		std::swap(__stride, rhs.__stride);
+		std::swap(__raw, rhs.__raw);
+		std::swap(__words, rhs.__words);
+	}
+
+	static bit_matrix identity(size_t n) {
+		bit_matrix _res(n, n);
+		for (size_t i = 0; i < n; ++i) {
+			_res.set(i, i);
+		}
+		return _res;
+	}
+
+	size_t rows() const noexcept {
+		return __rows;
+	}
+
+	size_t cols() const noexcept {
+		return __cols;
+	}
+
+	/*ÿռõ*/
+	size_t stride() const noexcept {
+		return __stride;
+	}
+
+	word* row_data(size_t row) noexcept {
+		return __words + row * __stride;
+	}
+
+	const word* row_data(size_t row) const noexcept {
+		return __words + row * __stride;
+	}
+
+	bool get(size_t row, size_t col) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (row >= __rows || col >= __cols)
+			throw std::out_of_range("bit_matrix out of range");
+#endif
+		return (row_data(row)[col / 64] >> (col % 64)) & 1;
+	}
+
+	void set(size_t row, size_t col, bool val = true) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (row >= __rows || col >= __cols)
+			throw std::out_of_range("bit_matrix out of range");
+#endif
+		auto& _word = row_data(row)[col / 64];
+		_word = (_word & ~(word(1) << (col % 64))) | (word(val) << (col % 64));
+	}
+
+	void flip(size_t row, size_t col) NOEXCEPT_RELEASE {
+		set(row, col, !get(row, col));
+	}
+
+	dynamic_bitset row(size_t row) const {
+		dynamic_bitset _res;
+		_res.resize(__cols);
+		auto _data = row_data(row);
+		for (size_t i = 0; i < _res.word_count(); ++i) {
+			_res.set_word(i, _data[i]);
+		}
+		return _res;
+	}
+
+	/*cols()λضϣĲ0*/
+	void set_row(size_t row, const dynamic_bitset& val) noexcept {
+		auto _data = row_data(row);
+		std::fill(_data, _data + __stride, word(0));
+		auto _words = std::min(val.word_count(), __cols / 64 + (__cols % 64 != 0));
+		for (size_t i = 0; i < _words; ++i) {
+			_data[i] = val.get_word(i);
+		}
+		if (__cols % 64 != 0 && _words == __cols / 64 + 1) {
+			_data[_words - 1] &= (word(1) << (__cols % 64)) - 1;
+		}
+	}
+
+	std::vector<dynamic_bitset> to_rows() const {
+		std::vector<dynamic_bitset> _res;
+		_res.reserve(__rows);
+		for (size_t i = 0; i < __rows; ++i) {
+			_res.push_back(row(i));
+		}
+		return _res;
+	}
+
+	/*dst ^= src*/
+	void xor_row(size_t dst, size_t src) noexcept {
+		xor_words(row_data(dst), row_data(src), 0, __stride);
+	}
+
+	void swap_rows(size_t lhs, size_t rhs) noexcept {
+		std::swap_ranges(row_data(lhs), row_data(lhs) + __stride, row_data(rhs));
+	}
+
+	bool operator==(const bit_matrix& rhs) const noexcept {
+		if (__rows != rhs.__rows || __cols != rhs.__cols)
+			return false;
+		return __rows == 0 || std::memcmp(__words, rhs.__words, __rows * __stride * sizeof(word)) == 0;
+	}
+
+	bool operator!=(const bit_matrix& rhs) const noexcept {
+		return !(*this == rhs);
+	}
+
+	/*GF(2)ϵļӷ״ͬ*/
+	bit_matrix& operator^=(const bit_matrix& rhs) {
+		if (__rows != rhs.__rows || __cols != rhs.__cols)
+			throw std::invalid_argument("bit_matrix shape mismatch");
+		xor_words(__words, rhs.__words, 0, __rows * __stride);
+		return *this;
+	}
+
+	bit_matrix operator^(const bit_matrix& rhs) const {
+		auto _res(*this);
+		return _res ^= rhs;
+	}
+
+	/*64x64תãÿԭתдԳλ*/
+	bit_matrix transpose() const {
+		bit_matrix _res(__cols, __rows);
+		word _block[64];
+		for (size_t _row = 0; _row < __rows; _row += 64) {
+			auto _rows = std::min<size_t>(64, __rows - _row);
+			for (size_t _col = 0; _col < __cols; _col += 64) {
+				auto _cols = std::min<size_t>(64, __cols - _col);
+				for (size_t i = 0; i < 64; ++i) {
+					_block[i] = i < _rows ? row_data(_row + i)[_col / 64] : 0;
+				}
+				transpose_64(_block);
+				for (size_t i = 0; i < _cols; ++i) {
+					_res.row_data(_col + i)[_row / 64] = _block[i];
+				}
+			}
+		}
+		return _res;
+	}
+
+	/*Four-Russians˷(M4RM)rhsÿ8нһ256ıÿȡӦ8λ*/
+	bit_matrix operator*(const bit_matrix& rhs) const {
+		if (__cols != rhs.__rows)
+			throw std::invalid_argument("bit_matrix shape mismatch");
+		bit_matrix _res(__rows, rhs.__cols);
+		std::vector<word> _table;
+		const word* _group[russian_bits()];
+		for (size_t _first = 0; _first < __cols; _first += russian_bits()) {
+			auto _count = std::min(russian_bits(), __cols - _first);
+			for (size_t i = 0; i < _count; ++i) {
+				_group[i] = rhs.row_data(_first + i);
+			}
+			rhs.build_table(_table, _group, _count, 0);
+			/*8ж룬Խֱ߽*/
+			auto _shift = _first % 64;
+			for (size_t i = 0; i < __rows; ++i) {
+				auto _index = (row_data(i)[_first / 64] >> _shift) & ((word(1) << _count) - 1);
+				if (_index != 0) {
+					xor_words(_res.row_data(i), _table.data() + _index * rhs.__stride, 0, rhs.__stride);
+				}
+			}
+		}
+		return _res;
+	}
+
+	bit_matrix& operator*=(const bit_matrix& rhs) {
+		auto _res = *this * rhs;
+		swap(_res);
+		return *this;
+	}
+
+	/*
+	* Four-RussiansԪ(M4RI)ԭػΪнΣreducedΪtrueʱΪΣ
+	* ÿδ8Уʣҳ8ڵԪʹԪȥ˴˵ԪУ
+	* ԪеϱЩԪϵλһ
+	*/
+	size_t eliminate(bool reduced = true) {
+		size_t _rank = 0;
+		std::vector<word> _table;
+		const word* _pivots[russian_bits()];
+		size_t _pivot_cols[russian_bits()];
+		for (size_t _first = 0; _first < __cols && _rank < __rows; _first += russian_bits()) {
+			auto _last = std::min(__cols, _first + russian_bits());
+			auto _first_word = _first / 64;
+			size_t _found = 0;
+			for (size_t _col = _first; _col < _last && _rank + _found < __rows; ++_col) {
+				for (size_t i = _rank + _found; i < __rows; ++i) {
+					/*ѡñеԪȥжһǷΪ1*/
+					auto _row = row_data(i);
+					for (size_t p = 0; p < _found; ++p) {
+						if ((_row[_pivot_cols[p] / 64] >> (_pivot_cols[p] % 64)) & 1) {
+							xor_words(_row, _pivots[p], _first_word, __stride);
+						}
+					}
+					if (((_row[_col / 64] >> (_col % 64)) & 1) == 0)
+						continue;
+					auto _pivot_row = _rank + _found;
+					swap_rows(i, _pivot_row);
+					auto _pivot = row_data(_pivot_row);
+					for (size_t p = 0; p < _found; ++p) {
+						auto _other = row_data(_rank + p);
+						if ((_other[_col / 64] >> (_col % 64)) & 1) {
+							xor_words(_other, _pivot, _first_word, __stride);
+						}
+					}
+					_pivots[_found] = _pivot;
+					_pivot_cols[_found] = _col;
+					++_found;
+					break;
+				}
+			}
+			if (_found == 0)
+				continue;
+			build_table(_table, _pivots, _found, _first_word);
+			auto _clear = [&](size_t i) {
+				auto _row = row_data(i);
+				size_t _index = 0;
+				for (size_t p = 0; p < _found; ++p) {
+					_index |= size_t((_row[_pivot_cols[p] / 64] >> (_pivot_cols[p] % 64)) & 1) << p;
+				}
+				if (_index != 0) {
+					xor_words(_row, _table.data() + _index * __stride, _first_word, __stride);
+				}
+			};
+			if (reduced) {
+				for (size_t i = 0; i < _rank; ++i) {
+					_clear(i);
+				}
+			}
+			for (size_t i = _rank + _found; i < __rows; ++i) {
+				_clear(i);
+			}
+			_rank += _found;
+		}
+		return _rank;
+	}
+
+	size_t rank() const {
+		auto _tmp(*this);
+		return _tmp.eliminate(false);
+	}
+};
+
+#undef NOEXCEPT_RELEASE
+#endif // !BIT_MATRIX_HPP
@@ -0,0 +1,232 @@
+#pragma once
+#ifndef BIT_STREAM_HPP
+#define BIT_STREAM_HPP
+
+/*
+* 䳤(Elias-gammaGolombvarint)õλд
+* dynamic_bitsetĴ洢һ£пǰλֵĵλ
+* һnλӵλʼд룬һԪk0һ1
+* ˶ȡһԪʱǴڵλ0count-trailing-zeros
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+#if defined DEBUG || defined _DEBUG
+#define NOEXCEPT_RELEASE
+#else
+#define NOEXCEPT_RELEASE noexcept
+#endif
+
+namespace bit_stream_detail {
+	/*nλΪ1n <= 64*/
+	inline std::uint64_t low_mask(size_t n) noexcept {
+		return n >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1;
+	}
+}
+
+/*
+* dynamic_bitsetĩβ׷λ64λۼƴӣһֲд
+* δһֵĲflush()ʱд룻ڴ֮ǰoutԶȡԭеλд
+* writerڼ䲻Ҫͨ;޸out
+*/
+class bit_writer
+{
+private:
+	dynamic_bitset* __out;
+	std::uint64_t __acc{};
+	/*ۼеλʼС64*/
+	size_t __fill{};
+
+	/*
+	* ԤۼҪдǸֵflush()ֻڵȣڴ
+	* չأСȲͷڴ
+	*/
+	void reserve_pending_word() {
+		auto _need = __out->size() / 64 * 64 + 64;
+		if (__out->capacity() < _need) {
+			auto _size = __out->size();
+			__out->resize(_need);
+			__out->resize(_size);
+		}
+	}
+
+	/*дǶ뵽64λ__out->size()ȡһֵλ*/
+	void emit(std::uint64_t word) {
+		auto _base = __out->size() / 64 * 64;
+		__out->resize(_base + 64);
+		__out->set_word(_base / 64, word);
+		reserve_pending_word();
+	}
+
+public:
+	/*outĩβһֵλƽۼoutԭȣ֮д붼ֶ*/
+	explicit bit_writer(dynamic_bitset& out) :__out(&out) {
+		auto _size = out.size();
+		__fill = _size % 64;
+		if (__fill != 0) {
+			__acc = out.get_word(_size / 64) & bit_stream_detail::low_mask(__fill);
+		}
+		reserve_pending_word();
+	}
+
+	bit_writer(const bit_writer&) = delete;
+	bit_writer& operator=(const bit_writer&) = delete;
+
+	~bit_writer() noexcept {
+		flush();
+	}
+
+	/*дvalĵnλn <= 64*/
+	void write(std::uint64_t val, size_t n) {
+#if defined DEBUG || defined _DEBUG
+		if (n > 64)
+			throw std::out_of_range("bit_writer code too long");
+#endif
+		if (n == 0)
+			return;
+		val &= bit_stream_detail::low_mask(n);
+		__acc |= val << __fill;
+		if (__fill + n >= 64) {
+			emit(__acc);
+			__acc = __fill == 0 ? 0 : val >> (64 - __fill);
+			__fill = __fill + n - 64;
+		}
+		else {
+			__fill += n;
+		}
+	}
+
+	void write_bit(bool val) {
+		write(val, 1);
+	}
+
+	/*k0һ1*/
+	void write_unary(size_t k) {
+		while (k >= 64) {
+			write(0, 64);
+			k -= 64;
+		}
+		write(std::uint64_t(1) << k, k + 1);
+	}
+
+	/*Elias-gammaval >= 1һԪдλ1дȥλĵλ*/
+	void write_gamma(std::uint64_t val) {
+#if defined DEBUG || defined _DEBUG
+		if (val == 0)
+			throw std::out_of_range("bit_writer gamma of 0");
+#endif
+		auto _k = size_t(63 - dynamic_bitset::countl_zero(val));
+		write_unary(_k);
+		write(val, _k);
+	}
+
+	/*ۼеʣλдout֮ԿɼдѾԤ׳쳣*/
+	void flush() noexcept {
+		if (__fill == 0)
+			return;
+		auto _base = __out->size() / 64 * 64;
+		__out->resize(_base + __fill);
+		__out->set_word(_base / 64, __acc);
+	}
+
+	/*дλۼе*/
+	size_t size() const noexcept {
+		return __out->size() / 64 * 64 + __fill;
+	}
+};
+
+/*dynamic_bitsetаλ˳ȡsize()λΪ0*/
+class bit_reader
+{
+private:
+	const dynamic_bitset* __in;
+	size_t __pos;
+
+	std::uint64_t word(size_t i) const noexcept {
+		return i < __in->word_count() ? __in->get_word(i) : 0;
+	}
+
+public:
+	explicit bit_reader(const dynamic_bitset& in, size_t pos = 0) noexcept :__in(&in), __pos(pos) {}
+
+	/*ӵǰλÿʼ64λһλλ*/
+	std::uint64_t window() const noexcept {
+		auto _index = __pos / 64;
+		auto _offset = __pos % 64;
+		auto _res = word(_index) >> _offset;
+		if (_offset != 0) {
+			_res |= word(_index + 1) << (64 - _offset);
+		}
+		return _res;
+	}
+
+	/*nλƶλãn <= 64*/
+	std::uint64_t peek(size_t n) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (n > 64)
+			throw std::out_of_range("bit_reader code too long");
+#endif
+		return window() & bit_stream_detail::low_mask(n);
+	}
+
+	std::uint64_t read(size_t n) NOEXCEPT_RELEASE {
+		auto _res = peek(n);
+		__pos += n;
+		return _res;
+	}
+
+	bool read_bit() NOEXCEPT_RELEASE {
+		return read(1) != 0;
+	}
+
+	void skip(size_t n) noexcept {
+		__pos += n;
+	}
+
+	/*ȡһԪ룬1֮ǰ0ĸ*/
+	size_t read_unary() NOEXCEPT_RELEASE {
+		size_t _count = 0;
+		auto _window = window();
+		while (_window == 0) {
+			if (__pos >= __in->size()) {
+#if defined DEBUG || defined _DEBUG
+				throw std::out_of_range("bit_reader out of range");
+#endif
+				return _count;
+			}
+			_count += 64;
+			__pos += 64;
+			_window = window();
+		}
+		auto _zeros = size_t(dynamic_bitset::countr_zero(_window));
+		__pos += _zeros + 1;
+		return _count + _zeros;
+	}
+
+	std::uint64_t read_gamma() NOEXCEPT_RELEASE {
+		auto _k = read_unary();
+		return (std::uint64_t(1) << _k) | read(_k);
+	}
+
+	size_t position() const noexcept {
+		return __pos;
+	}
+
+	void seek(size_t pos) noexcept {
+		__pos = pos;
+	}
+
+	size_t remaining() const noexcept {
+		return __pos < __in->size() ? __in->size() - __pos : 0;
+	}
+
+	bool eof() const noexcept {
+		return __pos >= __in->size();
+	}
+};
+
+#undef NOEXCEPT_RELEASE
+#endif // !BIT_STREAM_HPP
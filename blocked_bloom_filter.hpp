@@ -0,0 +1,220 @@
+#pragma once
+#ifndef BLOCKED_BLOOM_FILTER_HPP
+#define BLOCKED_BLOOM_FILTER_HPP
+
+/*
+* ֿBloom(split block Bloom filter)ײ洢һdynamic_bitset
+* ÿ512λһ64ֽڻУֳ864λ
+* һֻһУ8иһλͲѯֻһУ
+* 8ֵԱһ512λ(256λ)
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined _MSC_VER
+#include <xmmintrin.h>
+#endif
+
+class blocked_bloom_filter
+{
+private:
+	using word = std::uint64_t;
+
+	static constexpr size_t block_words() noexcept {
+		return 8;
+	}
+
+	static constexpr size_t block_bits() noexcept {
+		return block_words() * 64;
+	}
+
+	/*ǰԤȡľ*/
+	static constexpr size_t prefetch_distance() noexcept {
+		return 8;
+	}
+
+	dynamic_bitset __bits;
+
+	/*__bitsĳȾƶĶΪ0*/
+	size_t blocks() const noexcept {
+		return __bits.size() / block_bits();
+	}
+
+	/*÷Ĺϣ(std::hashǺӳ)ȴɢһ*/
+	static word mix(word hash) noexcept {
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	/*32λѡ飬˷ȡλȡģ0ʱΪ0÷ȼblocks()*/
+	size_t block_of(word hash) const noexcept {
+		return size_t(((hash >> 32) * word(blocks())) >> 32);
+	}
+
+	/*32λֱ8ȡ6λÿһλ*/
+	static void make_mask(word hash, word* mask) noexcept {
+		static const std::uint32_t _salt[block_words()] = {
+			0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+			0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+		};
+		auto _key = std::uint32_t(hash);
+		for (size_t i = 0; i < block_words(); ++i) {
+			mask[i] = word(1) << (std::uint32_t(_key * _salt[i]) >> 26);
+		}
+	}
+
+	std::uint8_t* block_data(size_t block) noexcept {
+		return __bits.data() + block * block_bits() / 8;
+	}
+
+	const std::uint8_t* block_data(size_t block) const noexcept {
+		return __bits.data() + block * block_bits() / 8;
+	}
+
+	static void prefetch(const void* ptr) noexcept {
+#if defined __GNUC__ || defined __clang__
+		__builtin_prefetch(ptr);
+#elif defined _MSC_VER
+		_mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+		(void)ptr;
+#endif
+	}
+
+	void insert_mixed(word hash) noexcept {
+		if (blocks() == 0)
+			return;
+		word _mask[block_words()];
+		word _block[block_words()];
+		make_mask(hash, _mask);
+		auto _data = block_data(block_of(hash));
+		std::memcpy(_block, _data, sizeof(_block));
+		for (size_t i = 0; i < block_words(); ++i) {
+			_block[i] |= _mask[i];
+		}
+		std::memcpy(_data, _block, sizeof(_block));
+	}
+
+	bool contains_mixed(word hash) const noexcept {
+		if (blocks() == 0)
+			return false;
+		word _mask[block_words()];
+		word _block[block_words()];
+		make_mask(hash, _mask);
+		std::memcpy(_block, block_data(block_of(hash)), sizeof(_block));
+		/*ǰ˳8һȽ*/
+		word _missing = 0;
+		for (size_t i = 0; i < block_words(); ++i) {
+			_missing |= _mask[i] & ~_block[i];
+		}
+		return _missing == 0;
+	}
+
+public:
+	/*һ飬֤insert/containsʵ64ֽ*/
+	blocked_bloom_filter() :blocked_bloom_filter(block_bits()) {}
+
+	/*λȡ512ı*/
+	explicit blocked_bloom_filter(size_t bits) {
+		__bits.resize(std::max<size_t>(1, (bits + block_bits() - 1) / block_bits()) * block_bits());
+	}
+
+	/*bits()лȱ512ķ㱶*/
+	explicit blocked_bloom_filter(dynamic_bitset bits)
+		:__bits(std::move(bits)) {
+		if (blocks() == 0 || __bits.size() % block_bits() != 0)
+			throw std::invalid_argument("blocked_bloom_filter size must be a multiple of 512 bits");
+	}
+
+	/*ԤԪʹλֿĶöԼ20%Ŀռֲ*/
+	static blocked_bloom_filter for_capacity(size_t n, double false_positive_rate) {
+		if (!(false_positive_rate > 0 && false_positive_rate < 1))
+			throw std::invalid_argument("blocked_bloom_filter false positive rate must be in (0, 1)");
+		auto _ln2 = std::log(2.0);
+		auto _bits = -double(n) * std::log(false_positive_rate) / (_ln2 * _ln2) * 1.2;
+		return blocked_bloom_filter(size_t(std::max(_bits, double(block_bits()))));
+	}
+
+	size_t size_in_bits() const noexcept {
+		return __bits.size();
+	}
+
+	/*hashǼ64λϣֵstd::hashĽ*/
+	void insert(word hash) noexcept {
+		insert_mixed(mix(hash));
+	}
+
+	bool contains(word hash) const noexcept {
+		return contains_mixed(mix(hash));
+	}
+
+	/*룬ǰprefetch_distance()ԤȡڵĿ飬ڸʵĻȱʧ*/
+	void insert(const word* hashes, size_t n) noexcept {
+		word _mixed[prefetch_distance()];
+		for (size_t i = 0; i < n && i < prefetch_distance(); ++i) {
+			_mixed[i] = mix(hashes[i]);
+			prefetch(block_data(block_of(_mixed[i])));
+		}
+		for (size_t i = 0; i < n; ++i) {
+			auto _hash = _mixed[i % prefetch_distance()];
+			if (i + prefetch_distance() < n) {
+				auto& _next = _mixed[i % prefetch_distance()];
+				_next = mix(hashes[i + prefetch_distance()]);
+				prefetch(block_data(block_of(_next)));
+			}
+			insert_mixed(_hash);
+		}
+	}
+
+	/*ѯout[i]ΪiǷܴ*/
+	void contains(const word* hashes, size_t n, bool* out) const noexcept {
+		word _mixed[prefetch_distance()];
+		for (size_t i = 0; i < n && i < prefetch_distance(); ++i) {
+			_mixed[i] = mix(hashes[i]);
+			prefetch(block_data(block_of(_mixed[i])));
+		}
+		for (size_t i = 0; i < n; ++i) {
+			auto _hash = _mixed[i % prefetch_distance()];
+			if (i + prefetch_distance() < n) {
+				auto& _next = _mixed[i % prefetch_distance()];
+				_next = mix(hashes[i + prefetch_distance()]);
+				prefetch(block_data(block_of(_next)));
+			}
+			out[i] = contains_mixed(_hash);
+		}
+	}
+
+	/*Ĳλͬ*/
+	blocked_bloom_filter& operator|=(const blocked_bloom_filter& rhs) {
+		if (blocks() != rhs.blocks())
+			throw std::invalid_argument("blocked_bloom_filter size mismatch");
+		__bits |= rhs.__bits;
+		return *this;
+	}
+
+	blocked_bloom_filter operator|(const blocked_bloom_filter& rhs) const {
+		auto _res(*this);
+		return _res |= rhs;
+	}
+
+	void clear() noexcept {
+		std::memset(__bits.data(), 0, __bits.size() / 8);
+	}
+
+	/*ײλֱлblocked_bloom_filter(dynamic_bitset)ָ*/
+	const dynamic_bitset& bits() const noexcept {
+		return __bits;
+	}
+};
+
+#endif // !BLOCKED_BLOOM_FILTER_HPP
@@ -0,0 +1,317 @@
+#pragma once
+#ifndef COUNTED_DYNAMIC_BITSET_HPP
+#define COUNTED_DYNAMIC_BITSET_HPP
+
+/*
+* popcountdynamic_bitsetʺcount()Զ޸ĵĳ
+* ÿ4096λ()һλдO(1)¼
+* ֻӰĳΪ࣬´count()ʱͳЩ
+* count()const»棬߳ͬʱҪⲿͬ
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined DEBUG || defined _DEBUG
+#define NOEXCEPT_RELEASE
+#else
+#define NOEXCEPT_RELEASE noexcept
+#endif
+
+class counted_dynamic_bitset
+{
+private:
+	static constexpr size_t superblock_bits() noexcept {
+		return 4096;
+	}
+
+	static constexpr size_t superblock_words() noexcept {
+		return superblock_bits() / 64;
+	}
+
+	dynamic_bitset __bits;
+	/*__countʼյ__super֮ͣ೬ļǾֵ*/
+	mutable std::vector<std::uint16_t> __super;
+	mutable size_t __count{};
+	/*೬ķΧ[__dirty_first, __dirty_last)*/
+	mutable size_t __dirty_first{};
+	mutable size_t __dirty_last{};
+	/*__superӦĳȣͨmutate()ı䳤Ⱥ__bits.size()һ£Ҫؽ*/
+	mutable size_t __synced_size{};
+
+	static size_t superblocks_of(size_t bits) noexcept {
+		return bits / superblock_bits() + (bits % superblock_bits() != 0);
+	}
+
+	bool is_dirty(size_t superblock) const noexcept {
+		return superblock >= __dirty_first && superblock < __dirty_last;
+	}
+
+	void mark_dirty(size_t first, size_t last) noexcept {
+		last = std::min(last, __super.size());
+		if (first >= last)
+			return;
+		if (__dirty_first >= __dirty_last) {
+			__dirty_first = first;
+			__dirty_last = last;
+		}
+		else {
+			__dirty_first = std::min(__dirty_first, first);
+			__dirty_last = std::max(__dirty_last, last);
+		}
+	}
+
+	/*ⲿıʱ޷֪ЩλؽȫΪ*/
+	void sync() const {
+		if (__bits.size() == __synced_size)
+			return;
+		__super.assign(superblocks_of(__bits.size()), 0);
+		__count = 0;
+		__dirty_first = 0;
+		__dirty_last = __super.size();
+		__synced_size = __bits.size();
+	}
+
+	void refresh() const noexcept {
+		auto _words = __bits.word_count();
+		for (size_t i = __dirty_first; i < __dirty_last; ++i) {
+			auto _last = std::min(_words, (i + 1) * superblock_words());
+			std::uint16_t _count = 0;
+			for (size_t j = i * superblock_words(); j < _last; ++j) {
+				_count += std::uint16_t(dynamic_bitset::popcount(__bits.get_word(j)));
+			}
+			__count += _count;
+			__count -= __super[i];
+			__super[i] = _count;
+		}
+		__dirty_first = __dirty_last = 0;
+	}
+
+	/*ȸıͬ飬λ0ɾĳмȥ*/
+	void resize_superblocks(size_t old_size) {
+		auto _new_size = __bits.size();
+		auto _superblocks = superblocks_of(_new_size);
+		if (_superblocks < __super.size()) {
+			for (size_t i = _superblocks; i < __super.size(); ++i) {
+				__count -= __super[i];
+			}
+			__super.resize(_superblocks);
+			__dirty_last = std::min(__dirty_last, _superblocks);
+		}
+		else {
+			__super.resize(_superblocks, 0);
+		}
+		/*ضһһ*/
+		if (_new_size < old_size && _new_size % superblock_bits() != 0) {
+			mark_dirty(_superblocks - 1, _superblocks);
+		}
+		__synced_size = _new_size;
+	}
+
+public:
+	class bit_ref {
+	private:
+		counted_dynamic_bitset* __bind;
+		size_t __index;
+	public:
+		bit_ref(counted_dynamic_bitset* bind, size_t index) noexcept :__bind(bind), __index(index) {}
+
+		bit_ref& operator=(bool val) {
+			__bind->set(__index, val);
+			return *this;
+		}
+
+		bit_ref& operator=(const bit_ref& rhs) {
+			return *this = bool(rhs);
+		}
+
+		operator bool() const NOEXCEPT_RELEASE {
+			return __bind->test(__index);
+		}
+
+		size_t index() const noexcept {
+			return __index;
+		}
+	};
+
+	counted_dynamic_bitset() noexcept {}
+
+	/*гΪ࣬һcount()ʱͳ*/
+	explicit counted_dynamic_bitset(dynamic_bitset bits)
+		:__bits(std::move(bits)), __super(superblocks_of(__bits.size())), __synced_size(__bits.size()) {
+		mark_dirty(0, __super.size());
+	}
+
+	explicit counted_dynamic_bitset(const std::string& val)
+		:counted_dynamic_bitset(dynamic_bitset(val)) {}
+
+	/*ֻͼ*/
+	const dynamic_bitset& get() const noexcept {
+		return __bits;
+	}
+
+	/*
+	* дͼгΪࣻҲԸı䣬´εñʱؽ
+	* ñӿ֮Ҫµmutate()ܼͨ޸
+	*/
+	dynamic_bitset& mutate() noexcept {
+		mark_dirty(0, __super.size());
+		return __bits;
+	}
+
+	/*ȡڲdynamic_bitset֮󱾶Ϊ*/
+	dynamic_bitset release() noexcept {
+		auto _res = std::move(__bits);
+		__super.clear();
+		__count = 0;
+		__dirty_first = __dirty_last = 0;
+		__synced_size = 0;
+		return _res;
+	}
+
+	size_t size() const noexcept {
+		return __bits.size();
+	}
+
+	/*û೬ʱO(1)*/
+	size_t count() const {
+		sync();
+		if (__dirty_first < __dirty_last) {
+			refresh();
+		}
+		return __count;
+	}
+
+	bool test(size_t index) const NOEXCEPT_RELEASE {
+		return __bits[index];
+	}
+
+	/*O(1)ڳʱֻдλrefreshʱͳ*/
+	void set(size_t index, bool val = true) {
+		sync();
+		auto _ref = __bits[index];
+		if (bool(_ref) == val)
+			return;
+		_ref = val;
+		auto _superblock = index / superblock_bits();
+		if (is_dirty(_superblock))
+			return;
+		if (val) {
+			++__super[_superblock];
+			++__count;
+		}
+		else {
+			--__super[_superblock];
+			--__count;
+		}
+	}
+
+	bit_ref operator[](size_t index) NOEXCEPT_RELEASE {
+		return bit_ref(this, index);
+	}
+
+	bool operator[](size_t index) const NOEXCEPT_RELEASE {
+		return test(index);
+	}
+
+	bit_ref at(size_t index) NOEXCEPT_RELEASE {
+		return bit_ref(this, index);
+	}
+
+	bool at(size_t index) const NOEXCEPT_RELEASE {
+		return test(index);
+	}
+
+	void resize(size_t new_size) {
+		sync();
+		auto _old_size = __bits.size();
+		__bits.resize(new_size);
+		resize_superblocks(_old_size);
+	}
+
+	void push_back(bool val) {
+		resize(size() + 1);
+		set(size() - 1, val);
+	}
+
+	void pop_back(size_t count = 1) {
+		resize(size() - count);
+	}
+
+	void clear() noexcept {
+		__bits.clear();
+		__super.clear();
+		__count = 0;
+		__dirty_first = __dirty_last = 0;
+		__synced_size = 0;
+	}
+
+	/*rhs֮λᱻ㣬Χ*/
+	counted_dynamic_bitset& operator&=(const dynamic_bitset& rhs) {
+		sync();
+		auto _old_size = __bits.size();
+		__bits &= rhs;
+		resize_superblocks(_old_size);
+		mark_dirty(0, __super.size());
+		return *this;
+	}
+
+	/*ֻrhsǵĳı*/
+	counted_dynamic_bitset& operator|=(const dynamic_bitset& rhs) {
+		sync();
+		auto _old_size = __bits.size();
+		__bits |= rhs;
+		resize_superblocks(_old_size);
+		mark_dirty(0, superblocks_of(rhs.size()));
+		return *this;
+	}
+
+	counted_dynamic_bitset& operator^=(const dynamic_bitset& rhs) {
+		sync();
+		auto _old_size = __bits.size();
+		__bits ^= rhs;
+		resize_superblocks(_old_size);
+		mark_dirty(0, superblocks_of(rhs.size()));
+		return *this;
+	}
+
+	counted_dynamic_bitset& operator&=(const counted_dynamic_bitset& rhs) {
+		return *this &= rhs.__bits;
+	}
+
+	counted_dynamic_bitset& operator|=(const counted_dynamic_bitset& rhs) {
+		return *this |= rhs.__bits;
+	}
+
+	counted_dynamic_bitset& operator^=(const counted_dynamic_bitset& rhs) {
+		return *this ^= rhs.__bits;
+	}
+
+	bool operator==(const counted_dynamic_bitset& rhs) const noexcept {
+		return __bits == rhs.__bits;
+	}
+
+	bool operator!=(const counted_dynamic_bitset& rhs) const noexcept {
+		return __bits != rhs.__bits;
+	}
+
+	std::string to_string() const {
+		return __bits.to_string();
+	}
+
+	void swap(counted_dynamic_bitset& rhs) noexcept {
+		__bits.swap(rhs.__bits);
+		__super.swap(rhs.__super);
+		std::swap(__count, rhs.__count);
+		std::swap(__dirty_first, rhs.__dirty_first);
+		std::swap(__dirty_last, rhs.__dirty_last);
+		std::swap(__synced_size, rhs.__synced_size);
+	}
+};
+
+#undef NOEXCEPT_RELEASE
+#endif // !COUNTED_DYNAMIC_BITSET_HPP
@@ -8,11 +8,42 @@
 */
 
 #include <cstring>
+#include <cstdlib>
 #include <string>
 #include <memory>
 #include <algorithm>
 #include <stdexcept>
 #include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#if defined _MSC_VER
+#include <intrin.h>
+#endif
+#if defined _WIN32
+#include <malloc.h>
+#endif
+#if defined __AVX512F__
+#include <immintrin.h>
+#endif
+/*MSVCλڽڳֵеãC++20֮ǰ޷ֻ֣ܷconstexpr*/
+#if defined _MSC_VER && !defined __clang__ && !defined __cpp_lib_is_constant_evaluated
+#define DYNAMIC_BITSET_BIT_CONSTEXPR
+#else
+#define DYNAMIC_BITSET_BIT_CONSTEXPR constexpr
+#endif
+#if defined __unix__ || defined __APPLE__
+#include <sys/mman.h>
+#define DYNAMIC_BITSET_HAS_MMAP
+#endif
+#if __cplusplus >= 202002L || (defined _MSVC_LANG && _MSVC_LANG >= 202002L)
+#include <compare>
+#include <span>
+#endif
+#if defined DYNAMIC_BITSET_STATS
+#include <atomic>
+#include <mutex>
+#endif
 
 
 #if defined DEBUG || defined _DEBUG
@@ -21,12 +52,144 @@
 #define NOEXCEPT_RELEASE noexcept
 #endif
 
+/*
+* DYNAMIC_BITSET_STATSͳڴ䡢ʱδʱûκο
+* ̱߳棬ֻ߳д룬˵ҪԭӶ--д
+*/
+#if defined DYNAMIC_BITSET_STATS
+class dynamic_bitset_stats
+{
+public:
+	enum counter : size_t {
+		allocations,		/*ѷ*/
+		deallocations,		/*ͷŴ*/
+		bytes_allocated,	/*ֽ*/
+		bytes_deallocated,	/*ͷŵֽ*/
+		bytes_moved,		/*memmovemove_bits˵ֽ*/
+		instances,			/*Ķ*/
+		heap_spills,		/*ssoתΪѴ洢Ĵͬһclear()ݻټһΣƶ첻*/
+		growths,			/*resize·ڴĴ*/
+		temporaries,		/*ڲʱ*/
+		counter_count
+	};
+
+	struct snapshot {
+		std::uint64_t values[counter_count]{};
+
+		std::uint64_t operator[](counter c) const noexcept {
+			return values[c];
+		}
+
+		snapshot& operator+=(const snapshot& rhs) noexcept {
+			for (size_t i = 0; i < counter_count; ++i) {
+				values[i] += rhs.values[i];
+			}
+			return *this;
+		}
+	};
+
+	static const char* name(counter c) noexcept {
+		static const char* const _names[counter_count] = {
+			"allocations", "deallocations", "bytes_allocated", "bytes_deallocated", "bytes_moved",
+			"instances", "heap_spills", "growths", "temporaries"
+		};
+		return _names[c];
+	}
+
+	static void add(counter c, std::uint64_t n) noexcept {
+		auto& _value = local().__values[c];
+		_value.store(_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	/*ǰ̵߳ļ*/
+	static snapshot thread_snapshot() noexcept {
+		return local().load();
+	}
+
+	/*̣߳˳̣߳ļ֮*/
+	static snapshot global_snapshot() {
+		std::lock_guard<std::mutex> _lock(registry_mutex());
+		auto _res = retired();
+		for (auto _elem : registry()) {
+			_res += _elem->load();
+		}
+		return _res;
+	}
+
+	static void reset_thread() noexcept {
+		local().reset();
+	}
+
+	/*̵߳Ĳͬʱʱܶʧ*/
+	static void reset_global() {
+		std::lock_guard<std::mutex> _lock(registry_mutex());
+		retired() = snapshot();
+		for (auto _elem : registry()) {
+			_elem->reset();
+		}
+	}
+
+private:
+	struct thread_counters {
+		std::atomic<std::uint64_t> __values[counter_count]{};
+
+		thread_counters() {
+			std::lock_guard<std::mutex> _lock(registry_mutex());
+			registry().push_back(this);
+		}
+
+		~thread_counters() {
+			std::lock_guard<std::mutex> _lock(registry_mutex());
+			retired() += load();
+			auto& _registry = registry();
+			_registry.erase(std::find(_registry.begin(), _registry.end(), this));
+		}
+
+		snapshot load() const noexcept {
+			snapshot _res;
+			for (size_t i = 0; i < counter_count; ++i) {
+				_res.values[i] = __values[i].load(std::memory_order_relaxed);
+			}
+			return _res;
+		}
+
+		void reset() noexcept {
+			for (auto& _value : __values) {
+				_value.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	static thread_counters& local() {
+		thread_local thread_counters _counters;
+		return _counters;
+	}
+
+	static std::mutex& registry_mutex() {
+		static std::mutex _mutex;
+		return _mutex;
+	}
+
+	static std::vector<thread_counters*>& registry() {
+		static std::vector<thread_counters*> _registry;
+		return _registry;
+	}
+
+	static snapshot& retired() {
+		static snapshot _retired;
+		return _retired;
+	}
+};
+
+#define DYNAMIC_BITSET_STAT(c, n) dynamic_bitset_stats::add(dynamic_bitset_stats::c, (n))
+#else
+#define DYNAMIC_BITSET_STAT(c, n) ((void)0)
+#endif
+
 class dynamic_bitset
-	:private std::allocator<std::uint8_t>/*ջŻ*/
 {
 private:
 	using byte = std::uint8_t;
-	using alloc = std::allocator<byte>;
 
 private:
 	/*ssoŻsize() <= 14 * 8ʱҪڴ
@@ -113,24 +276,6 @@ private:
 		}
 	}
 
-	constexpr byte* data() noexcept {
-		if (is_short()) {
-			return &__mypair.s.__data[0];
-		}
-		else {
-			return __mypair.l.__data;
-		}
-	}
-
-	constexpr const byte* data() const noexcept {
-		if (is_short()) {
-			return &__mypair.s.__data[0];
-		}
-		else {
-			return __mypair.l.__data;
-		}
-	}
-
 	constexpr void set_size(size_t size) noexcept {
 		if (is_short()) {
 			/*                                    λ      λ*/
@@ -156,7 +301,288 @@ private:
 	}
 
 	constexpr void set_flag(bool is_short) noexcept {
-		__mypair.s.__size = (__mypair.s.__size & ~1) | ~(int)is_short;
+		__mypair.s.__size = (std::uint16_t)((__mypair.s.__size & ~1) | (is_short ? 0 : 1));
+	}
+
+	/*ڴ水ж룬SIMDдԽ*/
+	static constexpr size_t heap_alignment() noexcept {
+		return 64;
+	}
+
+	/*
+	* СֽĻֱϵͳӳ䣺2MB벢͸ҳڴϵͳ״ηʱ
+	* union_all/thresholdȲʱҲ·ÿһmmap+madvise+munmap(Լ5us)
+	* ʡmemsetȱҳҲΪ1/5122MBʱԱͨѷԼ10%32MBʱ2(benchhuge_page_*)
+	*/
+	static constexpr size_t huge_page_threshold() noexcept {
+		return size_t(2) << 20;
+	}
+
+	/*bytesֽڣzeroedڴǷѾȫΪ0*/
+	static byte* allocate_bytes(size_t bytes, bool& zeroed) {
+#if defined DYNAMIC_BITSET_HAS_MMAP
+		if (bytes >= huge_page_threshold()) {
+			/*ӳһҳٲõβʹʼַҳ*/
+			auto _len = bytes + huge_page_threshold();
+			void* _raw = mmap(nullptr, _len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (_raw == MAP_FAILED)
+				throw std::bad_alloc();
+			auto _first = reinterpret_cast<std::uintptr_t>(_raw);
+			auto _aligned = (_first + huge_page_threshold() - 1) & ~std::uintptr_t(huge_page_threshold() - 1);
+			if (_aligned != _first) {
+				munmap(_raw, _aligned - _first);
+			}
+			if (_first + _len != _aligned + bytes) {
+				munmap(reinterpret_cast<void*>(_aligned + bytes), _first + _len - (_aligned + bytes));
+			}
+#if defined MADV_HUGEPAGE
+			madvise(reinterpret_cast<void*>(_aligned), bytes, MADV_HUGEPAGE);
+#endif
+			zeroed = true;
+			return reinterpret_cast<byte*>(_aligned);
+		}
+#endif
+		void* _ptr = nullptr;
+#if defined _WIN32
+		_ptr = _aligned_malloc(bytes, heap_alignment());
+#else
+		if (posix_memalign(&_ptr, heap_alignment(), bytes) != 0)
+			_ptr = nullptr;
+#endif
+		if (_ptr == nullptr)
+			throw std::bad_alloc();
+		zeroed = false;
+		return static_cast<byte*>(_ptr);
+	}
+
+	/*bytesʱͬݴжڴ·*/
+	static void deallocate_bytes(byte* ptr, size_t bytes) noexcept {
+#if defined DYNAMIC_BITSET_HAS_MMAP
+		if (bytes >= huge_page_threshold()) {
+			munmap(ptr, bytes);
+			return;
+		}
+#endif
+#if defined _WIN32
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+	/*ͷŶڴ沢صյsso״̬*/
+	void release() noexcept {
+		if (!is_short()) {
+			DYNAMIC_BITSET_STAT(deallocations, 1);
+			DYNAMIC_BITSET_STAT(bytes_deallocated, memory_allocated());
+			deallocate_bytes(data(), memory_allocated());
+		}
+		__mypair = __pair{};
+	}
+
+	/*[first, last)λ*/
+	void clear_bits(size_t first, size_t last) noexcept {
+		auto _data = data();
+		auto _first_byte = first / 8;
+		auto _last_byte = last / 8 + (last % 8 != 0);
+		if (first % 8 != 0) {
+			_data[_first_byte] &= byte((1 << (first % 8)) - 1);
+			++_first_byte;
+		}
+		if (_last_byte > _first_byte) {
+			std::memset(_data + _first_byte, 0, _last_byte - _first_byte);
+		}
+	}
+
+	/*[first, last)λΪvalӰ췶Χλ*/
+	void fill_bits(size_t first, size_t last, bool val) noexcept {
+		if (first >= last)
+			return;
+		auto _data = data();
+		auto _first_byte = first / 8;
+		auto _last_byte = last / 8;
+		auto _fill = byte(val ? 0xff : 0);
+		auto _merge = [&](size_t i, byte mask) {
+			_data[i] = byte((_data[i] & ~mask) | (_fill & mask));
+		};
+		if (_first_byte == _last_byte) {
+			_merge(_first_byte, byte(((1 << (last % 8)) - 1) & ~((1 << (first % 8)) - 1)));
+			return;
+		}
+		if (first % 8 != 0) {
+			_merge(_first_byte, byte(~((1 << (first % 8)) - 1)));
+			++_first_byte;
+		}
+		std::memset(_data + _first_byte, _fill, _last_byte - _first_byte);
+		if (last % 8 != 0) {
+			_merge(_last_byte, byte((1 << (last % 8)) - 1));
+		}
+	}
+
+	/*
+	* src_data[src, src + n)λƵdst_data[dst, dst + n)߿ͬһڴ沢ص
+	* ƫƲ8ıʱֽmemmoveֻ޲βֽڣĿֶ룬ÿԴƴ(funnel shift)
+	*/
+	static void move_bits(byte* dst_data, size_t dst_size, size_t dst,
+		const byte* src_data, size_t src_size, size_t src, size_t n) noexcept {
+		if (n == 0)
+			return;
+		DYNAMIC_BITSET_STAT(bytes_moved, (n + 7) / 8);
+		auto _last = dst + n;
+		if ((dst - src) % 8 == 0) {
+			auto _first_byte = dst / 8;
+			auto _last_byte = (_last - 1) / 8;
+			byte _head = dst_data[_first_byte];
+			byte _tail = dst_data[_last_byte];
+			std::memmove(dst_data + _first_byte, src_data + src / 8, _last_byte - _first_byte + 1);
+			auto _head_mask = byte((1 << (dst % 8)) - 1);
+			dst_data[_first_byte] = byte((dst_data[_first_byte] & ~_head_mask) | (_head & _head_mask));
+			if (_last % 8 != 0) {
+				auto _tail_mask = byte(~((1 << (_last % 8)) - 1));
+				dst_data[_last_byte] = byte((dst_data[_last_byte] & ~_tail_mask) | (_tail & _tail_mask));
+			}
+			return;
+		}
+
+		auto _src_word = [&](size_t i) -> std::uint64_t {
+			return i * 64 < src_size ? load_word(src_data, src_size, i) : 0;
+		};
+		/*ӵposλʼ64λֻ[pos, src + n)*/
+		auto _read = [&](size_t pos) {
+			auto _index = pos / 64;
+			auto _offset = pos % 64;
+			if ((_index + 2) * 64 <= src_size) {
+				auto _low = load_full_word(src_data, _index);
+				auto _high = load_full_word(src_data, _index + 1);
+				return _offset == 0 ? _low : _low >> _offset | _high << (64 - _offset);
+			}
+			auto _word = _src_word(_index) >> _offset;
+			if (_offset != 0) {
+				_word |= _src_word(_index + 1) << (64 - _offset);
+			}
+			return _word;
+		};
+		auto _move_word = [&](size_t i) {
+			auto _first_bit = std::max(dst, i * 64);
+			auto _last_bit = std::min(_last, i * 64 + 64);
+			auto _word = _read(_first_bit - dst + src) << (_first_bit - i * 64);
+			if (_last_bit - _first_bit != 64) {
+				auto _mask = ((_last_bit - i * 64 == 64 ? 0 : 1ULL << (_last_bit - i * 64)) - 1)
+					& ~((1ULL << (_first_bit - i * 64)) - 1);
+				_word = (load_word(dst_data, dst_size, i) & ~_mask) | (_word & _mask);
+			}
+			store_word(dst_data, dst_size, i, _word);
+		};
+		/*λƶʱӺǰ֤ȡԴλûб*/
+		auto _first_word = dst / 64;
+		auto _last_word = (_last - 1) / 64;
+		if (dst_data == src_data && dst > src) {
+			for (auto i = _last_word + 1; i-- > _first_word;) {
+				_move_word(i);
+			}
+		}
+		else {
+			for (auto i = _first_word; i <= _last_word; ++i) {
+				_move_word(i);
+			}
+		}
+	}
+
+	/*wordΪ1λչΪbase + λţдoutдλãǡдpopcount(word)*/
+	template<class Index>
+	static Index* decode_word(std::uint64_t word, Index base, Index* out) noexcept {
+#if defined __AVX512F__
+		if (word == 0)
+			return out;
+		/*VPCOMPRESSѡе±У洢ֻдЧĲ*/
+		if (sizeof(Index) == 4) {
+			const __m512i _lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			for (int j = 0; j < 4; ++j, word >>= 16) {
+				auto _mask = __mmask16(word & 0xffff);
+				auto _index = _mm512_add_epi32(_mm512_set1_epi32(int(base + Index(16 * j))), _lanes);
+				auto _count = popcount(_mask);
+				_mm512_mask_storeu_epi32(out, __mmask16((1u << _count) - 1), _mm512_maskz_compress_epi32(_mask, _index));
+				out += _count;
+			}
+			return out;
+		}
+		else {
+			const __m512i _lanes = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+			for (int j = 0; j < 8; ++j, word >>= 8) {
+				auto _mask = __mmask8(word & 0xff);
+				auto _index = _mm512_add_epi64(_mm512_set1_epi64((long long)(base + Index(8 * j))), _lanes);
+				auto _count = popcount(_mask);
+				_mm512_mask_storeu_epi64(out, __mmask8((1u << _count) - 1), _mm512_maskz_compress_epi64(_mask, _index));
+				out += _count;
+			}
+			return out;
+		}
+#else
+		/*ȡλ1ֽڲڲв*/
+		while (word != 0) {
+			*out++ = base + Index(countr_zero(word));
+			word &= word - 1;
+		}
+		return out;
+#endif
+	}
+
+	template<class Index>
+	size_t decode_indices(size_t first, size_t last, Index* out) const noexcept {
+		if (first >= last)
+			return 0;
+		auto _data = data();
+		auto _size = size();
+		auto _begin = out;
+		auto _first_word = first / 64;
+		auto _last_word = (last - 1) / 64;
+		for (auto i = _first_word; i <= _last_word; ++i) {
+			auto _word = (i + 1) * 64 <= _size ? load_full_word(_data, i) : load_word(_data, _size, i);
+			if (i == _first_word) {
+				_word &= ~0ULL << (first % 64);
+			}
+			if (i == _last_word && last % 64 != 0) {
+				_word &= (1ULL << (last % 64)) - 1;
+			}
+			out = decode_word(_word, Index(i * 64), out);
+		}
+		return size_t(out - _begin);
+	}
+
+	/*·ڴѾ㣬±λɣûз֧±ʱҲȷ*/
+	template<class Index>
+	static dynamic_bitset encode_indices(const Index* indices, size_t count, size_t size) {
+		dynamic_bitset _res;
+		_res.resize(size);
+		auto _data = _res.data();
+		for (size_t i = 0; i < count; ++i) {
+#if defined DEBUG || defined _DEBUG
+			if (indices[i] >= size)
+				throw std::out_of_range("dynamic_bitset out of range");
+#endif
+			_data[indices[i] / 8] |= byte(1 << (indices[i] % 8));
+		}
+		return _res;
+	}
+
+	template<class Index>
+	static dynamic_bitset encode_indices(const Index* indices, size_t count) {
+		size_t _size = 0;
+		for (size_t i = 0; i < count; ++i) {
+			_size = std::max(_size, size_t(indices[i]) + 1);
+		}
+		return encode_indices(indices, count, _size);
+	}
+
+	/*Сԭݣ㹻ʱ·䣻Ȱѳ0resizeͲḴƾݣڶϵĶҲssoת*/
+	void reset_size(size_t new_size) {
+		if (new_size > cap()) {
+			set_size(0);
+			resize(new_size);
+		}
+		else {
+			set_size(new_size);
+		}
 	}
 
 	static constexpr size_t max_cap_without_alloc() noexcept {
@@ -179,24 +605,252 @@ private:
 		num |= num >> 32;
 		return num + 1;
 	}
+
+	/*64λִٶС˴洢iλλڵi/64ֵĵi%64λ*/
+	static constexpr size_t word_of_bits(size_t bits) noexcept {
+		return bits / 64 + (bits % 64 != 0);
+	}
+
+	/*ȡi֣÷ֶ֤size()*/
+	static std::uint64_t load_full_word(const byte* data, size_t i) noexcept {
+		std::uint64_t _word;
+		std::memcpy(&_word, data + i * 8, 8);
+		return _word;
+	}
+
+	/*ȡi֣bitsЧλ*/
+	static std::uint64_t load_word(const byte* data, size_t bits, size_t i) noexcept {
+		std::uint64_t _word = 0;
+		if ((i + 1) * 64 <= bits) {
+			std::memcpy(&_word, data + i * 8, 8);
+			return _word;
+		}
+		auto _tail = bits - i * 64;
+		std::memcpy(&_word, data + i * 8, (_tail + 7) / 8);
+		return _word & ((1ULL << _tail) - 1);
+	}
+
+	/*дiֻ֣дbitsڵֽڣһֽڵЧλд0*/
+	static void store_word(byte* data, size_t bits, size_t i, std::uint64_t val) noexcept {
+		if ((i + 1) * 64 <= bits) {
+			std::memcpy(data + i * 8, &val, 8);
+			return;
+		}
+		auto _tail = bits - i * 64;
+		val &= (1ULL << _tail) - 1;
+		std::memcpy(data + i * 8, &val, (_tail + 7) / 8);
+	}
+
+	/*tile[j] = op(tile[j], inputĵfirst + j)inputȵΪ0*/
+	template<class Op>
+	static void combine_tile(std::uint64_t* tile, const dynamic_bitset& input, size_t first, size_t n, Op op) noexcept {
+		auto _size = input.size();
+		auto _data = input.data();
+		auto _words = word_of_bits(_size);
+		auto _end = first + n;
+		auto _full_end = std::min(_end, std::max(first, _size / 64));
+		size_t i = first;
+		for (; i < _full_end; ++i) {
+			tile[i - first] = op(tile[i - first], load_full_word(_data, i));
+		}
+		for (; i < _end; ++i) {
+			tile[i - first] = op(tile[i - first], i < _words ? load_word(_data, _size, i) : 0);
+		}
+	}
+
+	/*ԭذ㣬rhsϳʱչȣ϶ʱΪ0*/
+	template<class Op>
+	void combine_assign(const dynamic_bitset& rhs, Op op) {
+		auto _rhs_size = rhs.size();
+		if (_rhs_size > size()) {
+			resize(_rhs_size);
+		}
+		auto _size = size();
+		auto _data = data();
+		auto _rhs_data = rhs.data();
+		auto _words = word_of_bits(_size);
+		auto _rhs_words = word_of_bits(_rhs_size);
+		auto _full = std::min(_size, _rhs_size) / 64;
+		for (size_t i = 0; i < _full; ++i) {
+			auto _word = op(load_full_word(_data, i), load_full_word(_rhs_data, i));
+			std::memcpy(_data + i * 8, &_word, 8);
+		}
+		for (size_t i = _full; i < _words; ++i) {
+			auto _rhs_word = i < _rhs_words ? load_word(_rhs_data, _rhs_size, i) : 0;
+			store_word(_data, _size, i, op(load_word(_data, _size, i), _rhs_word));
+		}
+	}
+
+	/*·ÿδһϼܷŽL1*/
+	static constexpr size_t tile_words() noexcept {
+		return 256;
+	}
+
+	static size_t max_size_of(const dynamic_bitset* const* inputs, size_t count) noexcept {
+		size_t _max_size = 0;
+		for (size_t i = 0; i < count; ++i) {
+			_max_size = std::max(_max_size, inputs[i]->size());
+		}
+		return _max_size;
+	}
+
+	/*dst֮һʱдʱ󣬱߶д*/
+	template<class Fn>
+	static void write_n_way(dynamic_bitset& dst, const dynamic_bitset* const* inputs, size_t count, Fn fn) {
+		for (size_t i = 0; i < count; ++i) {
+			if (inputs[i] == &dst) {
+				DYNAMIC_BITSET_STAT(temporaries, 1);
+				dynamic_bitset _res;
+				fn(_res);
+				dst.swap(_res);
+				return;
+			}
+		}
+		fn(dst);
+	}
+
+	/*
+	* ͬʱbitsetÿ֣϶̵һΪ0op(lhs_word, rhs_word)0ʱǰtrue
+	* ߶ְ8һ鴦ûз֧ڱ
+	*/
+	template<class Op>
+	static bool any_word(const dynamic_bitset& lhs, const dynamic_bitset& rhs, Op op) noexcept {
+		constexpr size_t _block = 8;
+		auto _lhs_size = lhs.size();
+		auto _rhs_size = rhs.size();
+		auto _lhs_data = lhs.data();
+		auto _rhs_data = rhs.data();
+		auto _lhs_words = word_of_bits(_lhs_size);
+		auto _rhs_words = word_of_bits(_rhs_size);
+		auto _full = std::min(_lhs_size, _rhs_size) / 64;
+		size_t i = 0;
+		for (; i + _block <= _full; i += _block) {
+			std::uint64_t _acc = 0;
+			for (size_t j = i; j < i + _block; ++j) {
+				_acc |= op(load_full_word(_lhs_data, j), load_full_word(_rhs_data, j));
+			}
+			if (_acc != 0)
+				return true;
+		}
+		auto _words = std::max(_lhs_words, _rhs_words);
+		for (; i < _words; ++i) {
+			auto _lhs_word = i < _lhs_words ? load_word(_lhs_data, _lhs_size, i) : 0;
+			auto _rhs_word = i < _rhs_words ? load_word(_rhs_data, _rhs_size, i) : 0;
+			if (op(_lhs_word, _rhs_word) != 0)
+				return true;
+		}
+		return false;
+	}
+
+	/*64x64->128λ˷ߵλwyhashĻϺ*/
+	static std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined __SIZEOF_INT128__
+		auto _res = (unsigned __int128)a * b;
+		return (std::uint64_t)_res ^ (std::uint64_t)(_res >> 64);
+#elif defined _MSC_VER && defined _M_X64
+		std::uint64_t _high;
+		std::uint64_t _low = _umul128(a, b, &_high);
+		return _low ^ _high;
+#else
+		std::uint64_t _a_low = (std::uint32_t)a, _a_high = a >> 32;
+		std::uint64_t _b_low = (std::uint32_t)b, _b_high = b >> 32;
+		std::uint64_t _ll = _a_low * _b_low, _lh = _a_low * _b_high;
+		std::uint64_t _hl = _a_high * _b_low, _hh = _a_high * _b_high;
+		std::uint64_t _mid = (_ll >> 32) + (std::uint32_t)_lh + (std::uint32_t)_hl;
+		std::uint64_t _low = (_ll & 0xffffffffULL) | (_mid << 32);
+		std::uint64_t _high = _hh + (_lh >> 32) + (_hl >> 32) + (_mid >> 32);
+		return _low ^ _high;
+#endif
+	}
 public:
-	dynamic_bitset() noexcept {}
+	/*λ㹤ߣͷļеҲõC++20֮ǰMSVCⶼڳʽʹ*/
+	static DYNAMIC_BITSET_BIT_CONSTEXPR int popcount(std::uint64_t val) noexcept {
+#if defined __GNUC__ || defined __clang__
+		return __builtin_popcountll(val);
+#elif defined _MSC_VER && defined _M_X64 && !defined __cpp_lib_is_constant_evaluated
+		return (int)__popcnt64(val);
+#else
+#if defined _MSC_VER && defined _M_X64
+		if (!std::is_constant_evaluated())
+			return (int)__popcnt64(val);
+#endif
+		val = val - ((val >> 1) & 0x5555555555555555ULL);
+		val = (val & 0x3333333333333333ULL) + ((val >> 2) & 0x3333333333333333ULL);
+		val = (val + (val >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return int((val * 0x0101010101010101ULL) >> 56);
+#endif
+	}
 
-	~dynamic_bitset() noexcept {
-		if (!is_short()) {
-			alloc::deallocate(data(), memory_allocated());
+	/*valΪ0ʱδ*/
+	static DYNAMIC_BITSET_BIT_CONSTEXPR int countr_zero(std::uint64_t val) noexcept {
+#if defined __GNUC__ || defined __clang__
+		return __builtin_ctzll(val);
+#elif defined _MSC_VER && defined _M_X64 && !defined __cpp_lib_is_constant_evaluated
+		unsigned long _index;
+		_BitScanForward64(&_index, val);
+		return (int)_index;
+#else
+#if defined _MSC_VER && defined _M_X64
+		if (!std::is_constant_evaluated()) {
+			unsigned long _index;
+			_BitScanForward64(&_index, val);
+			return (int)_index;
+		}
+#endif
+		int _count = 0;
+		while ((val & 1) == 0) {
+			val >>= 1;
+			++_count;
+		}
+		return _count;
+#endif
+	}
+
+	/*valΪ0ʱδ*/
+	static DYNAMIC_BITSET_BIT_CONSTEXPR int countl_zero(std::uint64_t val) noexcept {
+#if defined __GNUC__ || defined __clang__
+		return __builtin_clzll(val);
+#elif defined _MSC_VER && defined _M_X64 && !defined __cpp_lib_is_constant_evaluated
+		unsigned long _index;
+		_BitScanReverse64(&_index, val);
+		return 63 - (int)_index;
+#else
+#if defined _MSC_VER && defined _M_X64
+		if (!std::is_constant_evaluated()) {
+			unsigned long _index;
+			_BitScanReverse64(&_index, val);
+			return 63 - (int)_index;
+		}
+#endif
+		int _count = 0;
+		while ((val & (1ULL << 63)) == 0) {
+			val <<= 1;
+			++_count;
 		}
+		return _count;
+#endif
+	}
+
+	dynamic_bitset() noexcept {
+		DYNAMIC_BITSET_STAT(instances, 1);
+	}
+
+	~dynamic_bitset() noexcept {
+		release();
 	}
 
 	dynamic_bitset(const dynamic_bitset& rhs) noexcept {
+		DYNAMIC_BITSET_STAT(instances, 1);
 		copy(rhs);
 	}
 
 	dynamic_bitset(dynamic_bitset&& rhs) noexcept {
+		DYNAMIC_BITSET_STAT(instances, 1);
 		copy(std::forward<dynamic_bitset&&>(rhs));
 	}
 
 	dynamic_bitset(const std::string& val) {
+		DYNAMIC_BITSET_STAT(instances, 1);
 		resize(val.size());
 		for (size_t i = 0; i < val.size(); ++i) {
 			if (val[i] == '1') {
@@ -206,6 +860,7 @@ public:
 	}
 
 	dynamic_bitset(size_t val) noexcept {
+		DYNAMIC_BITSET_STAT(instances, 1);
 		std::string res;
 		if (val == 0)
 			res = "0";
@@ -217,6 +872,7 @@ public:
 	}
 
 	dynamic_bitset(size_t lenth, size_t val) NOEXCEPT_RELEASE {
+		DYNAMIC_BITSET_STAT(instances, 1);
 #if defined _DEBUG || defined DEBUG
 		if (lenth <= 63 && (lenth == 0 || val >= (1ULL << lenth)))
 			throw std::out_of_range("ڳΪlenthĶval");
@@ -235,6 +891,25 @@ public:
 		}
 	}
 
+	/*ײֽڣiλdata()[i / 8]ĵi % 8λǰ(size() + 7) / 8ֽЧ*/
+	constexpr byte* data() noexcept {
+		if (is_short()) {
+			return &__mypair.s.__data[0];
+		}
+		else {
+			return __mypair.l.__data;
+		}
+	}
+
+	constexpr const byte* data() const noexcept {
+		if (is_short()) {
+			return &__mypair.s.__data[0];
+		}
+		else {
+			return __mypair.l.__data;
+		}
+	}
+
 	class bit_ref {
 	private:
 		dynamic_bitset* __bind;
@@ -346,21 +1021,35 @@ public:
 
 	/*resize0ʼڴ*/
 	void resize(size_t new_size) {
+		auto _old_size = size();
+		/*[_old_size, _clear_last)Ҫ㣬·ڴ֮Ѿ0*/
+		auto _clear_last = new_size;
 		if (new_size <= cap()) {
 			set_size(new_size);/*ڴ*/
 		}
 		else {
 			auto new_cap = round_up_to_power_of_2(new_size % 8 == 0 ? new_size / 8 : new_size / 8 + 1);
-			byte* new_data = alloc::allocate(new_cap);
-			if (new_data == nullptr)
-				throw std::bad_alloc();
+			bool _zeroed;
+			byte* new_data = allocate_bytes(new_cap, _zeroed);
+
+			DYNAMIC_BITSET_STAT(allocations, 1);
+			DYNAMIC_BITSET_STAT(bytes_allocated, new_cap);
+			DYNAMIC_BITSET_STAT(growths, 1);
+			DYNAMIC_BITSET_STAT(bytes_moved, byte_of_size());
 
-			memset(new_data, 0, new_cap);
+			/*ϵͳӳڴѾ0memsetҲǰҳ*/
+			if (!_zeroed) {
+				memset(new_data, 0, new_cap);
+			}
 			std::memmove(new_data, data(), byte_of_size());
+			_clear_last = byte_of_size() * 8;
 			if (!is_short()) {
-				alloc::deallocate(data(), memory_allocated());
+				DYNAMIC_BITSET_STAT(deallocations, 1);
+				DYNAMIC_BITSET_STAT(bytes_deallocated, memory_allocated());
+				deallocate_bytes(data(), memory_allocated());
 			}
 			else {
+				DYNAMIC_BITSET_STAT(heap_spills, 1);
 				set_flag(false);
 			}
 
@@ -368,6 +1057,10 @@ public:
 			set_size(new_size);
 			set_cap(new_cap * 8);
 		}
+		/*pop_backСµľҪ*/
+		if (new_size > _old_size) {
+			clear_bits(_old_size, std::min(new_size, _clear_last));
+		}
 	}
 
 	void push_back(bool val) {
@@ -401,10 +1094,344 @@ public:
 		set_size(0);
 	}
 
+	/*ֻȽǰsize()λһֽеЧλ*/
 	constexpr bool is_equal(const dynamic_bitset& rhs) const noexcept {
-		if (size() != rhs.size())
+		auto _size = size();
+		if (_size != rhs.size())
+			return false;
+		auto _full = _size / 8;
+		if (std::memcmp(data(), rhs.data(), _full) != 0)
 			return false;
-		return std::memcmp(data(), rhs.data(), size()) == 0;
+		if (_size % 8 == 0)
+			return true;
+		byte _mask = byte((1 << (_size % 8)) - 1);
+		return ((data()[_full] ^ rhs.data()[_full]) & _mask) == 0;
+	}
+
+	/*ֵȽϣto_string()ıȽϽ϶̵ǰ׺С*/
+	int compare(const dynamic_bitset& rhs) const noexcept {
+		auto _lhs_size = size();
+		auto _rhs_size = rhs.size();
+		auto _min_size = std::min(_lhs_size, _rhs_size);
+		auto _lhs_data = data();
+		auto _rhs_data = rhs.data();
+		auto _words = word_of_bits(_min_size);
+		for (size_t i = 0; i < _words; ++i) {
+			auto _lhs_word = load_word(_lhs_data, _min_size, i);
+			auto _diff = _lhs_word ^ load_word(_rhs_data, _min_size, i);
+			if (_diff != 0) {
+				return (_lhs_word >> countr_zero(_diff)) & 1 ? 1 : -1;
+			}
+		}
+		if (_lhs_size == _rhs_size)
+			return 0;
+		return _lhs_size < _rhs_size ? -1 : 1;
+	}
+
+	/*64λַʣiֵĵjλǵ64 * i + jλsize()λΪ0д뱻*/
+	size_t word_count() const noexcept {
+		return word_of_bits(size());
+	}
+
+	std::uint64_t get_word(size_t i) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (i >= word_count())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		return load_word(data(), size(), i);
+	}
+
+	void set_word(size_t i, std::uint64_t val) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (i >= word_count())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		store_word(data(), size(), i, val);
+	}
+
+	/*ֵΪ1λ*/
+	size_t count() const noexcept {
+		auto _size = size();
+		auto _data = data();
+		auto _full = _size / 64;
+		size_t _count = 0;
+		for (size_t i = 0; i < _full; ++i) {
+			_count += popcount(load_full_word(_data, i));
+		}
+		if (_size % 64 != 0) {
+			_count += popcount(load_word(_data, _size, _full));
+		}
+		return _count;
+	}
+
+	/*
+	* ¼ϹϵλϱȽϣȲͬʱ϶̵һΪ0
+	* ֱӱݣʱܾ
+	*/
+	bool is_subset_of(const dynamic_bitset& rhs) const noexcept {
+		return !any_word(*this, rhs, [](std::uint64_t l, std::uint64_t r) { return l & ~r; });
+	}
+
+	bool is_proper_subset_of(const dynamic_bitset& rhs) const noexcept {
+		return is_subset_of(rhs) && any_word(*this, rhs, [](std::uint64_t l, std::uint64_t r) { return r & ~l; });
+	}
+
+	bool intersects(const dynamic_bitset& rhs) const noexcept {
+		return any_word(*this, rhs, [](std::uint64_t l, std::uint64_t r) { return l & r; });
+	}
+
+	bool is_disjoint(const dynamic_bitset& rhs) const noexcept {
+		return !intersects(rhs);
+	}
+
+	/*ȼ(*this & rhs).count()*/
+	size_t intersection_count(const dynamic_bitset& rhs) const noexcept {
+		auto _lhs_size = size();
+		auto _rhs_size = rhs.size();
+		auto _lhs_data = data();
+		auto _rhs_data = rhs.data();
+		auto _min_size = std::min(_lhs_size, _rhs_size);
+		auto _full = _min_size / 64;
+		size_t _count = 0;
+		for (size_t i = 0; i < _full; ++i) {
+			_count += popcount(load_full_word(_lhs_data, i) & load_full_word(_rhs_data, i));
+		}
+		if (_min_size % 64 != 0) {
+			_count += popcount(load_word(_lhs_data, _min_size, _full) & load_word(_rhs_data, _min_size, _full));
+		}
+		return _count;
+	}
+
+	/*
+	* ·ֵ㣬дdstΪߣ϶̵Ϊ0
+	* tile_wordsַֿ飬ÿκϲ룬ͼʼڻ
+	*/
+	static void intersect_all(dynamic_bitset& dst, const dynamic_bitset* const* inputs, size_t count) {
+		write_n_way(dst, inputs, count, [&](dynamic_bitset& res) {
+			auto _size = max_size_of(inputs, count);
+			res.reset_size(_size);
+			auto _data = res.data();
+			auto _words = word_of_bits(_size);
+			std::uint64_t _tile[tile_words()];
+			for (size_t _first = 0; _first < _words; _first += tile_words()) {
+				auto _n = std::min(tile_words(), _words - _first);
+				std::fill(_tile, _tile + _n, ~0ULL);
+				for (size_t i = 0; i < count; ++i) {
+					std::uint64_t _any = 0;
+					combine_tile(_tile, *inputs[i], _first, _n, [&](std::uint64_t l, std::uint64_t r) {
+						auto _res = l & r;
+						_any |= _res;
+						return _res;
+						});
+					/*ѾΪ0ʣµ벻ٶ*/
+					if (_any == 0)
+						break;
+				}
+				for (size_t j = 0; j < _n; ++j) {
+					store_word(_data, _size, _first + j, _tile[j]);
+				}
+			}
+			});
+	}
+
+	static void union_all(dynamic_bitset& dst, const dynamic_bitset* const* inputs, size_t count) {
+		write_n_way(dst, inputs, count, [&](dynamic_bitset& res) {
+			auto _size = max_size_of(inputs, count);
+			res.reset_size(_size);
+			auto _data = res.data();
+			auto _words = word_of_bits(_size);
+			std::uint64_t _tile[tile_words()];
+			for (size_t _first = 0; _first < _words; _first += tile_words()) {
+				auto _n = std::min(tile_words(), _words - _first);
+				std::fill(_tile, _tile + _n, 0ULL);
+				for (size_t i = 0; i < count; ++i) {
+					combine_tile(_tile, *inputs[i], _first, _n, [](std::uint64_t l, std::uint64_t r) { return l | r; });
+				}
+				for (size_t j = 0; j < _n; ++j) {
+					store_word(_data, _size, _first + j, _tile[j]);
+				}
+			}
+			});
+	}
+
+	/*
+	* kΪ1λΪ1
+	* ÿλõļλƬ棺pֵĵbλǵbмĵpλһμӷ64
+	*/
+	static void threshold(dynamic_bitset& dst, size_t k, const dynamic_bitset* const* inputs, size_t count) {
+		write_n_way(dst, inputs, count, [&](dynamic_bitset& res) {
+			auto _size = max_size_of(inputs, count);
+			res.reset_size(_size);
+			auto _data = res.data();
+			auto _words = word_of_bits(_size);
+			/*λΪkλļ뱥ͱ*/
+			size_t _planes = 0;
+			while (_planes < 64 && (k >> _planes) != 0) {
+				++_planes;
+			}
+			std::vector<std::uint64_t> _counter((_planes + 2) * tile_words());
+			auto _saturated = _counter.data() + _planes * tile_words();
+			auto _input = _saturated + tile_words();
+			for (size_t _first = 0; _first < _words; _first += tile_words()) {
+				auto _n = std::min(tile_words(), _words - _first);
+				std::fill(_counter.begin(), _counter.end(), 0ULL);
+				for (size_t i = 0; i < count; ++i) {
+					/*_inputΪλλвӷ*/
+					combine_tile(_input, *inputs[i], _first, _n, [](std::uint64_t, std::uint64_t r) { return r; });
+					for (size_t p = 0; p < _planes; ++p) {
+						auto _plane = _counter.data() + p * tile_words();
+						for (size_t j = 0; j < _n; ++j) {
+							auto _next = _plane[j] & _input[j];
+							_plane[j] ^= _input[j];
+							_input[j] = _next;
+						}
+					}
+					for (size_t j = 0; j < _n; ++j) {
+						_saturated[j] |= _input[j];
+					}
+				}
+				for (size_t j = 0; j < _n; ++j) {
+					/*λʼȽϼk*/
+					std::uint64_t _greater = 0, _equal = ~0ULL;
+					for (size_t p = _planes; p-- > 0;) {
+						auto _plane = _counter[p * tile_words() + j];
+						if ((k >> p) & 1) {
+							_equal &= _plane;
+						}
+						else {
+							_greater |= _equal & _plane;
+							_equal &= ~_plane;
+						}
+					}
+					store_word(_data, _size, _first + j, _saturated[j] | _greater | _equal);
+				}
+			}
+			});
+	}
+
+#if defined __cpp_lib_span
+	static void intersect_all(dynamic_bitset& dst, std::span<const dynamic_bitset* const> inputs) {
+		intersect_all(dst, inputs.data(), inputs.size());
+	}
+
+	static void union_all(dynamic_bitset& dst, std::span<const dynamic_bitset* const> inputs) {
+		union_all(dst, inputs.data(), inputs.size());
+	}
+
+	static void threshold(dynamic_bitset& dst, size_t k, std::span<const dynamic_bitset* const> inputs) {
+		threshold(dst, k, inputs.data(), inputs.size());
+	}
+#endif
+
+	/*
+	* Ϊ1λ±꣬дoutдĸ
+	* outҪcount()uint32_t汾Ҫsize()2^32
+	*/
+	size_t to_indices(std::uint32_t* out) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (size() > (size_t(1) << 32))
+			throw std::out_of_range("dynamic_bitset index overflows uint32_t");
+#endif
+		return decode_indices(0, size(), out);
+	}
+
+	size_t to_indices(std::uint64_t* out) const noexcept {
+		return decode_indices(0, size(), out);
+	}
+
+	/*ֻչ[first, last)ڷֿ鴦ÿ±ԿڻС*/
+	size_t to_indices(size_t first, size_t last, std::uint32_t* out) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (first > last || last > size() || last > (size_t(1) << 32))
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		return decode_indices(first, last, out);
+	}
+
+	size_t to_indices(size_t first, size_t last, std::uint64_t* out) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (first > last || last > size())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		return decode_indices(first, last, out);
+	}
+
+	void to_indices(std::vector<std::uint32_t>& out) const {
+		out.resize(count());
+		to_indices(out.data());
+	}
+
+	void to_indices(std::vector<std::uint64_t>& out) const {
+		out.resize(count());
+		to_indices(out.data());
+	}
+
+	/*±깹죬ֻһڴ棬size()Ϊ±1±겻*/
+	static dynamic_bitset from_indices(const std::uint32_t* indices, size_t count) {
+		return encode_indices(indices, count);
+	}
+
+	static dynamic_bitset from_indices(const std::uint64_t* indices, size_t count) {
+		return encode_indices(indices, count);
+	}
+
+	/*ָȣ±Сsize*/
+	static dynamic_bitset from_indices(const std::uint32_t* indices, size_t count, size_t size) {
+		return encode_indices(indices, count, size);
+	}
+
+	static dynamic_bitset from_indices(const std::uint64_t* indices, size_t count, size_t size) {
+		return encode_indices(indices, count, size);
+	}
+
+#if defined __cpp_lib_span
+	/*outcount()ʱ׳쳣дκݣoutСsize()ʱҪȼ*/
+	size_t to_indices(std::span<std::uint32_t> out) const {
+		if (out.size() < size() && out.size() < count())
+			throw std::out_of_range("dynamic_bitset index span too small");
+		return to_indices(out.data());
+	}
+
+	size_t to_indices(std::span<std::uint64_t> out) const {
+		if (out.size() < size() && out.size() < count())
+			throw std::out_of_range("dynamic_bitset index span too small");
+		return to_indices(out.data());
+	}
+
+	static dynamic_bitset from_indices(std::span<const std::uint32_t> indices) {
+		return from_indices(indices.data(), indices.size());
+	}
+
+	static dynamic_bitset from_indices(std::span<const std::uint64_t> indices) {
+		return from_indices(indices.data(), indices.size());
+	}
+
+	static dynamic_bitset from_indices(std::span<const std::uint32_t> indices, size_t size) {
+		return from_indices(indices.data(), indices.size(), size);
+	}
+
+	static dynamic_bitset from_indices(std::span<const std::uint64_t> indices, size_t size) {
+		return from_indices(indices.data(), indices.size(), size);
+	}
+#endif
+
+	/*Чλis_equalһ*/
+	size_t hash() const noexcept {
+		constexpr std::uint64_t _secret0 = 0xa0761d6478bd642fULL;
+		constexpr std::uint64_t _secret1 = 0xe7037ed1a0b428dbULL;
+		constexpr std::uint64_t _secret2 = 0x8ebc6af09c88c6e3ULL;
+		auto _size = size();
+		auto _data = data();
+		auto _words = word_of_bits(_size);
+		std::uint64_t _seed = _secret0 ^ mum(_size ^ _secret1, _secret2);
+		size_t i = 0;
+		for (; i + 1 < _words; i += 2) {
+			_seed = mum(load_word(_data, _size, i) ^ _secret1, load_word(_data, _size, i + 1) ^ _seed);
+		}
+		if (i < _words) {
+			_seed = mum(load_word(_data, _size, i) ^ _secret2, _seed);
+		}
+		return (size_t)mum(_seed ^ _secret0, _size ^ _secret1);
 	}
 
 	constexpr bool operator==(const dynamic_bitset& rhs) const noexcept {
@@ -415,14 +1442,53 @@ public:
 		return !is_equal(rhs);
 	}
 
+	bool operator<(const dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) < 0;
+	}
+
+	bool operator>(const dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) > 0;
+	}
+
+	bool operator<=(const dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) <= 0;
+	}
+
+	bool operator>=(const dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) >= 0;
+	}
+
+#if defined __cpp_lib_three_way_comparison
+	std::strong_ordering operator<=>(const dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) <=> 0;
+	}
+#endif
+
 	void copy(const dynamic_bitset& rhs) {
-		resize(rhs.size());
-		std::memmove(data(), rhs.data(), rhs.byte_of_size());
+		assign(rhs);
 	}
 
+	/*ֱӽӹrhsڴ棬rhsΪ*/
 	void copy(dynamic_bitset&& rhs) noexcept {
-		std::memmove(this, &rhs, sizeof(dynamic_bitset));
-		rhs.set_flag(true);//ֹտռ
+		if (this == &rhs)
+			return;
+		release();
+		__mypair = rhs.__mypair;
+		rhs.__mypair = __pair{};
+	}
+
+	/*㹻ʱڴ棬СҪʱƾ*/
+	void assign(const dynamic_bitset& rhs) {
+		if (this == &rhs)
+			return;
+		reset_size(rhs.size());
+		DYNAMIC_BITSET_STAT(bytes_moved, rhs.byte_of_size());
+		std::memmove(data(), rhs.data(), rhs.byte_of_size());
+	}
+
+	/*·ڴʱɵbit*/
+	constexpr size_t capacity() const noexcept {
+		return cap();
 	}
 
 	std::string to_string() const noexcept {
@@ -456,7 +1522,6 @@ public:
 
 	dynamic_bitset& operator=(dynamic_bitset&& rhs) noexcept {
 		copy(std::forward<dynamic_bitset&&>(rhs));
-		rhs.set_flag(true);
 		return *this;
 	}
 
@@ -471,6 +1536,7 @@ public:
 	}
 
 	dynamic_bitset operator~() const noexcept {
+		DYNAMIC_BITSET_STAT(temporaries, 1);
 		auto res(*this);
 		auto _size = res.byte_of_size();
 		auto _start = res.data();
@@ -481,6 +1547,7 @@ public:
 	}
 
 	dynamic_bitset operator<<(size_t n) const noexcept {
+		DYNAMIC_BITSET_STAT(temporaries, 1);
 		auto res(*this);
 		res.push_back(n, 0);
 		return res;
@@ -492,12 +1559,10 @@ public:
 	}
 
 	dynamic_bitset operator>>(size_t n) const {
+		DYNAMIC_BITSET_STAT(temporaries, 1);
 		dynamic_bitset res;
 		res.resize(size() + n);
-		auto _size = size();
-		for (size_t i = 0; i < _size; i++) {
-			res[n + i] = at(i);
-		}
+		move_bits(res.data(), res.size(), n, data(), size(), 0, size());
 		return res;
 	}
 
@@ -517,6 +1582,7 @@ public:
 	}
 
 	dynamic_bitset operator&(const dynamic_bitset& rhs) const {
+		DYNAMIC_BITSET_STAT(temporaries, 2);
 		auto _lhs(*this);
 		auto _rhs(rhs);
 		auto _lhs_size = _lhs.size();
@@ -541,12 +1607,29 @@ public:
 		return _lhs;
 	}
 
+	/*ԭ㣬ʱ󣬳ȡ߽ϴ*/
+	dynamic_bitset& operator&=(const dynamic_bitset& rhs) {
+		combine_assign(rhs, [](std::uint64_t l, std::uint64_t r) { return l & r; });
+		return *this;
+	}
+
+	dynamic_bitset& operator|=(const dynamic_bitset& rhs) {
+		combine_assign(rhs, [](std::uint64_t l, std::uint64_t r) { return l | r; });
+		return *this;
+	}
+
+	dynamic_bitset& operator^=(const dynamic_bitset& rhs) {
+		combine_assign(rhs, [](std::uint64_t l, std::uint64_t r) { return l ^ r; });
+		return *this;
+	}
+
 	dynamic_bitset& operator&=(size_t n) noexcept {
 		*this = (*this) & n;
 		return *this;
 	}
 
 	dynamic_bitset operator|(const dynamic_bitset& rhs) const {
+		DYNAMIC_BITSET_STAT(temporaries, 2);
 		auto _lhs(*this);
 		auto _rhs(rhs);
 		auto _lhs_size = _lhs.size();
@@ -577,6 +1660,7 @@ public:
 	}
 
 	dynamic_bitset operator^(const dynamic_bitset& rhs) const {
+		DYNAMIC_BITSET_STAT(temporaries, 2);
 		auto _lhs(*this);
 		auto _rhs(rhs);
 		auto _lhs_size = _lhs.size();
@@ -607,24 +1691,15 @@ public:
 	}
 
 	void push_front(bool val) noexcept {
-		*this >>= 1;
-		if (val == 1) {
-			at(0) = 1;
-		}
+		insert(0, 1, val);
 	}
 
 	void push_front(size_t n, bool val) noexcept {
-		*this >>= n;
-		if (val == 0) {
-			return;
-		}
-		for (size_t i = 0; i < n; ++i) {
-			at(i) = val;
-		}
+		insert(0, n, val);
 	}
 
 	void push_front_n(std::initializer_list<bool> list) noexcept {
-		*this >>= list.size();
+		insert(0, list.size(), false);
 		size_t i{};
 		for (const auto& elem : list) {
 			at(i++) = elem;
@@ -632,21 +1707,61 @@ public:
 	}
 
 	void push_back(const dynamic_bitset& rhs) noexcept {
-		for (auto& elem : rhs) {
-			push_back(bool(elem));
-		}
+		insert(size(), rhs);
 	}
 
 	void push_front(const dynamic_bitset& rhs) noexcept {
-		auto _Tmp(rhs);
-		_Tmp.push_back(*this);
-		swap(_Tmp);
+		insert(0, rhs);
 	}
 
+	/*posnvalpos֮λƶO(size() / 64)*/
+	void insert(size_t pos, size_t n, bool val) {
+#if defined DEBUG || defined _DEBUG
+		if (pos > size())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		auto _old_size = size();
+		resize(_old_size + n);
+		move_bits(data(), size(), pos + n, data(), size(), pos, _old_size - pos);
+		fill_bits(pos, pos + n, val);
+	}
+
+	void insert(size_t pos, const dynamic_bitset& rhs) {
+#if defined DEBUG || defined _DEBUG
+		if (pos > size())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		if (&rhs == this) {
+			DYNAMIC_BITSET_STAT(temporaries, 1);
+			auto _copy(rhs);
+			insert(pos, _copy);
+			return;
+		}
+		auto _old_size = size();
+		auto _n = rhs.size();
+		resize(_old_size + _n);
+		move_bits(data(), size(), pos + _n, data(), size(), pos, _old_size - pos);
+		move_bits(data(), size(), pos, rhs.data(), _n, 0, _n);
+	}
+
+	/*ɾ[first, last)֮λǰ*/
+	void erase(size_t first, size_t last) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (first > last || last > size())
+			throw std::out_of_range("dynamic_bitset out of range");
+#endif
+		auto _size = size();
+		move_bits(data(), _size, first, data(), _size, last, _size - last);
+		set_size(_size - (last - first));
+	}
+
+	void erase(size_t pos) NOEXCEPT_RELEASE {
+		erase(pos, pos + 1);
+	}
+
+	/*ֻ16ֽڵͷssoͶѴ洢*/
 	void swap(dynamic_bitset& rhs) noexcept {
-		dynamic_bitset _Tmp = std::move(rhs);
-		rhs = std::move(*this);
-		*this = std::move(_Tmp);
+		std::swap(__mypair, rhs.__mypair);
 	}
 public:
 	class iterator;
@@ -1050,5 +2165,21 @@ public:
 	}
 };
 
+inline size_t intersection_count(const dynamic_bitset& lhs, const dynamic_bitset& rhs) noexcept {
+	return lhs.intersection_count(rhs);
+}
+
+namespace std {
+	template<>
+	struct hash<dynamic_bitset> {
+		size_t operator()(const dynamic_bitset& val) const noexcept {
+			return val.hash();
+		}
+	};
+}
+
 #undef NOEXCEPT_RELEASE
+#undef DYNAMIC_BITSET_STAT
+#undef DYNAMIC_BITSET_HAS_MMAP
+#undef DYNAMIC_BITSET_BIT_CONSTEXPR
 #endif // !DYNAMIC_BITSET_HPP
@@ -0,0 +1,408 @@
+#pragma once
+#ifndef FINGERPRINT_COLLECTION_HPP
+#define FINGERPRINT_COLLECTION_HPP
+
+/*
+* ָƼϣHamming/Jaccard(Tanimoto)
+* ÿָһУд洢ʹaligned_rows.hppĲ
+* пڲѭǱڳȫչpopcount
+* ÿеpopcountԤȱ棬JaccardֻҪ㽻
+*/
+
+#include "aligned_rows.hpp"
+#include "dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class fingerprint_collection
+{
+public:
+	struct neighbor {
+		size_t index;
+		std::uint32_t distance;
+	};
+
+	struct pair {
+		size_t first;
+		size_t second;
+		std::uint32_t distance;
+	};
+
+private:
+	using word = std::uint64_t;
+
+	/*all-pairs鴦ָƺԼռôֽڣL1/L2*/
+	static constexpr size_t tile_bytes() noexcept {
+		return 32 * 1024;
+	}
+
+	size_t __bits;
+	size_t __stride;/*ÿе*/
+	size_t __size{};
+	size_t __capacity{};
+	std::unique_ptr<word[]> __raw;
+	word* __words{};
+	std::vector<std::uint32_t> __counts;
+
+	/*ڲ֪пstd::integral_constant÷ͬ*/
+	struct runtime_stride {
+		size_t __value;
+
+		constexpr operator size_t() const noexcept {
+			return __value;
+		}
+	};
+
+	/*пԱڳfnruntime_stride*/
+	template<class Fn>
+	void with_stride(Fn&& fn) const {
+		switch (__stride) {
+		case 1: fn(std::integral_constant<size_t, 1>()); break;
+		case 2: fn(std::integral_constant<size_t, 2>()); break;
+		case 4: fn(std::integral_constant<size_t, 4>()); break;
+		case 8: fn(std::integral_constant<size_t, 8>()); break;
+		case 16: fn(std::integral_constant<size_t, 16>()); break;
+		default: fn(runtime_stride{ __stride }); break;
+		}
+	}
+
+	void grow(size_t new_capacity) {
+		std::unique_ptr<word[]> _raw;
+		auto _words = aligned_rows_detail::allocate(_raw, new_capacity * __stride);
+		if (__size != 0) {
+			std::memcpy(_words, __words, __size * __stride * sizeof(word));
+		}
+		__raw = std::move(_raw);
+		__words = _words;
+		__capacity = new_capacity;
+	}
+
+	/*dynamic_bitsetתΪһУbits()ĲֽضϣĲ0*/
+	void to_row(const dynamic_bitset& val, word* row) const noexcept {
+		std::fill(row, row + __stride, word(0));
+		auto _words = std::min(val.word_count(), dynamic_bitset_words());
+		for (size_t i = 0; i < _words; ++i) {
+			row[i] = val.get_word(i);
+		}
+		if (__bits % 64 != 0) {
+			row[dynamic_bitset_words() - 1] &= (word(1) << (__bits % 64)) - 1;
+		}
+	}
+
+	size_t dynamic_bitset_words() const noexcept {
+		return __bits / 64 + (__bits % 64 != 0);
+	}
+
+	static std::uint32_t row_count(const word* row, size_t stride) noexcept {
+		std::uint32_t _count = 0;
+		for (size_t i = 0; i < stride; ++i) {
+			_count += dynamic_bitset::popcount(row[i]);
+		}
+		return _count;
+	}
+
+	template<class Stride>
+	static std::uint32_t row_xor_count(const word* lhs, const word* rhs, Stride stride) noexcept {
+		std::uint32_t _count = 0;
+		for (size_t i = 0; i < size_t(stride); ++i) {
+			_count += dynamic_bitset::popcount(lhs[i] ^ rhs[i]);
+		}
+		return _count;
+	}
+
+	template<class Stride>
+	static std::uint32_t row_and_count(const word* lhs, const word* rhs, Stride stride) noexcept {
+		std::uint32_t _count = 0;
+		for (size_t i = 0; i < size_t(stride); ++i) {
+			_count += dynamic_bitset::popcount(lhs[i] & rhs[i]);
+		}
+		return _count;
+	}
+
+	static double jaccard_of(std::uint32_t intersection, std::uint32_t lhs_count, std::uint32_t rhs_count) noexcept {
+		auto _union = lhs_count + rhs_count - intersection;
+		/*ռΪȫͬ*/
+		return _union == 0 ? 1.0 : double(intersection) / double(_union);
+	}
+
+	static unsigned thread_count(unsigned threads) noexcept {
+		if (threads == 0) {
+			threads = std::thread::hardware_concurrency();
+		}
+		return threads == 0 ? 1 : threads;
+	}
+
+	/*[0, n)ֳɶνthreadṣ߳fn(first, last, thread_index)*/
+	template<class Fn>
+	static void parallel_for(size_t n, unsigned threads, Fn fn) {
+		threads = (unsigned)std::min<size_t>(thread_count(threads), std::max<size_t>(n, 1));
+		if (threads <= 1) {
+			fn(size_t(0), n, 0u);
+			return;
+		}
+		std::vector<std::thread> _workers;
+		auto _chunk = (n + threads - 1) / threads;
+		for (unsigned t = 0; t < threads; ++t) {
+			auto _first = std::min(n, t * _chunk);
+			auto _last = std::min(n, _first + _chunk);
+			_workers.emplace_back([=] { fn(_first, _last, t); });
+		}
+		for (auto& _worker : _workers) {
+			_worker.join();
+		}
+	}
+
+	/*ѯָͬ64ֽڶ*/
+	struct query_row {
+		std::unique_ptr<word[]> __raw;
+		const word* __row;
+		std::uint32_t __count;
+
+		query_row(const fingerprint_collection& owner, const dynamic_bitset& val) {
+			auto _row = aligned_rows_detail::allocate(__raw, owner.__stride);
+			owner.to_row(val, _row);
+			__row = _row;
+			__count = row_count(_row, owner.__stride);
+		}
+	};
+
+public:
+	explicit fingerprint_collection(size_t bits)
+		:__bits(bits), __stride(aligned_rows_detail::stride_of(bits)) {}
+
+	fingerprint_collection(const fingerprint_collection& rhs)
+		:__bits(rhs.__bits), __stride(rhs.__stride), __counts(rhs.__counts) {
+		grow(rhs.__size);
+		__size = rhs.__size;
+		if (__size != 0) {
+			std::memcpy(__words, rhs.__words, __size * __stride * sizeof(word));
+		}
+	}
+
+	/*rhsΪͬλĿռ*/
+	fingerprint_collection(fingerprint_collection&& rhs) noexcept
+		:__bits(rhs.__bits), __stride(rhs.__stride),
+		__size(std::exchange(rhs.__size, 0)), __capacity(std::exchange(rhs.__capacity, 0)),
+		__raw(std::move(rhs.__raw)), __words(std::exchange(rhs.__words, nullptr)),
+		__counts(std::move(rhs.__counts)) {
+		rhs.__counts.clear();
+	}
+
+	fingerprint_collection& operator=(const fingerprint_collection& rhs) {
+		auto _tmp(rhs);
+		swap(_tmp);
+		return *this;
+	}
+
+	fingerprint_collection& operator=(fingerprint_collection&& rhs) noexcept {
+		fingerprint_collection _tmp(std::move(rhs));
+		swap(_tmp);
+		return *this;
+	}
+
+	void swap(fingerprint_collection& rhs) noexcept {
+		std::swap(__bits, rhs.__bits);
+		std::swap(__stride, rhs.__stride);
+		std::swap(__size, rhs.__size);
+		std::swap(__capacity, rhs.__capacity);
+		std::swap(__raw, rhs.__raw);
+		std::swap(__words, rhs.__words);
+		std::swap(__counts, rhs.__counts);
+	}
+
+	/*ÿָƵλ*/
+	size_t bits() const noexcept {
+		return __bits;
+	}
+
+	/*ָƸ*/
+	size_t size() const noexcept {
+		return __size;
+	}
+
+	/*ÿռõ*/
+	size_t stride() const noexcept {
+		return __stride;
+	}
+
+	void reserve(size_t n) {
+		if (n > __capacity) {
+			grow(n);
+		}
+		__counts.reserve(n);
+	}
+
+	void clear() noexcept {
+		__size = 0;
+		__counts.clear();
+	}
+
+	/*bits()ͬʱضϻ0*/
+	void push_back(const dynamic_bitset& val) {
+		if (__size == __capacity) {
+			grow(std::max<size_t>(16, __capacity * 2));
+		}
+		auto _row = __words + __size * __stride;
+		to_row(val, _row);
+		__counts.push_back(row_count(_row, __stride));
+		++__size;
+	}
+
+	dynamic_bitset at(size_t index) const {
+		dynamic_bitset _res;
+		_res.resize(__bits);
+		auto _row = row(index);
+		for (size_t i = 0; i < _res.word_count(); ++i) {
+			_res.set_word(i, _row[i]);
+		}
+		return _res;
+	}
+
+	dynamic_bitset operator[](size_t index) const {
+		return at(index);
+	}
+
+	/*indexָƵԭʼݣstride()*/
+	const std::uint64_t* row(size_t index) const noexcept {
+		return __words + index * __stride;
+	}
+
+	size_t count(size_t index) const noexcept {
+		return __counts[index];
+	}
+
+	std::uint32_t hamming(size_t lhs, size_t rhs) const noexcept {
+		return row_xor_count(row(lhs), row(rhs), __stride);
+	}
+
+	double jaccard(size_t lhs, size_t rhs) const noexcept {
+		return jaccard_of(row_and_count(row(lhs), row(rhs), __stride), __counts[lhs], __counts[rhs]);
+	}
+
+	/*ԶֵTanimotoϵJaccardϵͬ*/
+	double tanimoto(size_t lhs, size_t rhs) const noexcept {
+		return jaccard(lhs, rhs);
+	}
+
+	/*out[i] = queryiָƵHamming룬threadsΪ0ʱʹȫӲ߳*/
+	void hamming_to_all(const dynamic_bitset& query, std::uint32_t* out, unsigned threads = 1) const {
+		query_row _query(*this, query);
+		with_stride([&](auto stride) {
+			parallel_for(__size, threads, [&](size_t first, size_t last, unsigned) {
+				for (size_t i = first; i < last; ++i) {
+					out[i] = row_xor_count(_query.__row, __words + i * stride, stride);
+				}
+				});
+			});
+	}
+
+	void jaccard_to_all(const dynamic_bitset& query, double* out, unsigned threads = 1) const {
+		query_row _query(*this, query);
+		with_stride([&](auto stride) {
+			parallel_for(__size, threads, [&](size_t first, size_t last, unsigned) {
+				for (size_t i = first; i < last; ++i) {
+					out[i] = jaccard_of(row_and_count(_query.__row, __words + i * stride, stride), _query.__count, __counts[i]);
+				}
+				});
+			});
+	}
+
+	void tanimoto_to_all(const dynamic_bitset& query, double* out, unsigned threads = 1) const {
+		jaccard_to_all(query, out, threads);
+	}
+
+	/*HammingСkָƣ롢±*/
+	std::vector<neighbor> nearest_hamming(const dynamic_bitset& query, size_t k, unsigned threads = 1) const {
+		query_row _query(*this, query);
+		auto _less = [](const neighbor& lhs, const neighbor& rhs) {
+			return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.index < rhs.index;
+		};
+		/*ÿ߳άԼĴ󶥶ѣϲ*/
+		std::vector<std::vector<neighbor>> _heaps(thread_count(threads));
+		with_stride([&](auto stride) {
+			parallel_for(__size, threads, [&](size_t first, size_t last, unsigned t) {
+				auto& _heap = _heaps[t];
+				for (size_t i = first; i < last && k != 0; ++i) {
+					auto _distance = row_xor_count(_query.__row, __words + i * stride, stride);
+					/*ֻбȶѶĲҪѣԪﱻ*/
+					if (_heap.size() == k && _distance > _heap.front().distance)
+						continue;
+					neighbor _elem{ i, _distance };
+					if (_heap.size() < k) {
+						_heap.push_back(_elem);
+						std::push_heap(_heap.begin(), _heap.end(), _less);
+					}
+					else if (_less(_elem, _heap.front())) {
+						std::pop_heap(_heap.begin(), _heap.end(), _less);
+						_heap.back() = _elem;
+						std::push_heap(_heap.begin(), _heap.end(), _less);
+					}
+				}
+				});
+			});
+		std::vector<neighbor> _res;
+		for (const auto& _heap : _heaps) {
+			_res.insert(_res.end(), _heap.begin(), _heap.end());
+		}
+		auto _k = std::min(k, _res.size());
+		std::partial_sort(_res.begin(), _res.begin() + _k, _res.end(), _less);
+		_res.resize(_k);
+		return _res;
+	}
+
+	/*
+	* Hamming벻max_distanceָƶ(first < second)(first, second)
+	* ָưȽϣһԿ鶼ڻУ̴߳ӹȡ
+	*/
+	std::vector<pair> pairs_within_hamming(std::uint32_t max_distance, unsigned threads = 0) const {
+		auto _tile = std::max<size_t>(1, tile_bytes() / 2 / (__stride * sizeof(word)));
+		auto _tiles = (__size + _tile - 1) / _tile;
+		auto _tile_pairs = _tiles * (_tiles + 1) / 2;
+		std::atomic<size_t> _next{ 0 };
+		std::vector<std::vector<pair>> _found(thread_count(threads));
+		parallel_for(_found.size(), (unsigned)_found.size(), [&](size_t, size_t, unsigned t) {
+			auto& _res = _found[t];
+			for (size_t _job = _next++; _job < _tile_pairs; _job = _next++) {
+				/*_job(ti, tj)ti <= tjչ*/
+				size_t _ti = 0, _rest = _job;
+				while (_rest >= _tiles - _ti) {
+					_rest -= _tiles - _ti;
+					++_ti;
+				}
+				auto _tj = _ti + _rest;
+				auto _i_last = std::min(__size, (_ti + 1) * _tile);
+				auto _j_last = std::min(__size, (_tj + 1) * _tile);
+				with_stride([&](auto stride) {
+					for (size_t i = _ti * _tile; i < _i_last; ++i) {
+						auto _row = __words + i * stride;
+						auto _j_first = _ti == _tj ? i + 1 : _tj * _tile;
+						for (size_t j = _j_first; j < _j_last; ++j) {
+							auto _distance = row_xor_count(_row, __words + j * stride, stride);
+							if (_distance <= max_distance) {
+								_res.push_back({ i, j, _distance });
+							}
+						}
+					}
+					});
+			}
+			});
+		std::vector<pair> _res;
+		for (const auto& _elem : _found) {
+			_res.insert(_res.end(), _elem.begin(), _elem.end());
+		}
+		std::sort(_res.begin(), _res.end(), [](const pair& lhs, const pair& rhs) {
+			return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second < rhs.second;
+			});
+		return _res;
+	}
+};
+
+#endif // !FINGERPRINT_COLLECTION_HPP
@@ -0,0 +1,424 @@
+#pragma once
+#ifndef FIXED_DYNAMIC_BITSET_HPP
+#define FIXED_DYNAMIC_BITSET_HPP
+
+/*
+* ڱȷbitsetӿdynamic_bitsetһ£вڳʽʹ
+* 洢ΪN/64uint64_tѭǱڳȫչ
+* dynamic_bitsetssounion˫أڳֵʹãʹñ
+* count()ͱȽõdynamic_bitset::popcount/countr_zeroC++20֮ǰMSVCconstexpr
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#if defined DEBUG || defined _DEBUG
+#define NOEXCEPT_RELEASE
+#else
+#define NOEXCEPT_RELEASE noexcept
+#endif
+
+template<size_t N>
+class fixed_dynamic_bitset
+{
+private:
+	using word = std::uint64_t;
+
+	static constexpr size_t word_count = N / 64 + (N % 64 != 0) + (N == 0);
+
+	/*һЧλ룬NλʼձΪ0*/
+	static constexpr word tail_mask = N % 64 == 0 ? ~word(0) : (word(1) << (N % 64)) - 1;
+
+	word __words[word_count]{};
+
+	constexpr void assign_string(const char* str, size_t len) noexcept {
+		for (size_t i = 0; i < N && i < len; ++i) {
+			if (str[i] == '1') {
+				__words[i / 64] |= word(1) << (i % 64);
+			}
+		}
+	}
+
+	constexpr void trim() noexcept {
+		__words[word_count - 1] &= N == 0 ? 0 : tail_mask;
+	}
+
+public:
+	class bit_ref {
+	private:
+		fixed_dynamic_bitset* __bind;
+		size_t __index;
+	public:
+		constexpr bit_ref(fixed_dynamic_bitset* bind, size_t index) noexcept :__bind(bind), __index(index) {}
+
+		constexpr bit_ref& operator=(bool val) NOEXCEPT_RELEASE {
+			__bind->set(__index, val);
+			return *this;
+		}
+
+		constexpr bit_ref& operator=(const bit_ref& rhs) NOEXCEPT_RELEASE {
+			*this = bool(rhs);
+			return *this;
+		}
+
+		constexpr operator bool() const NOEXCEPT_RELEASE {
+			return __bind->test(__index);
+		}
+
+		constexpr size_t index() const noexcept {
+			return __index;
+		}
+	};
+
+	class const_iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = bool;
+	private:
+		const fixed_dynamic_bitset* __bind;
+		size_t __index;
+	public:
+		constexpr const_iterator(const fixed_dynamic_bitset* bind, size_t index) noexcept :__bind(bind), __index(index) {}
+
+		constexpr bool operator*() const NOEXCEPT_RELEASE {
+			return __bind->test(__index);
+		}
+
+		constexpr const_iterator& operator++() noexcept {
+			++__index;
+			return *this;
+		}
+
+		constexpr const_iterator& operator--() noexcept {
+			--__index;
+			return *this;
+		}
+
+		constexpr bool operator==(const const_iterator& rhs) const noexcept {
+			return __bind == rhs.__bind && __index == rhs.__index;
+		}
+
+		constexpr bool operator!=(const const_iterator& rhs) const noexcept {
+			return !(*this == rhs);
+		}
+	};
+
+	constexpr fixed_dynamic_bitset() noexcept {}
+
+	/*dynamic_bitset(const std::string&)ͬstr[i] == '1'ӦiλNַ*/
+	template<size_t M>
+	constexpr fixed_dynamic_bitset(const char(&str)[M]) noexcept {
+		assign_string(str, M - 1);
+	}
+
+	fixed_dynamic_bitset(const std::string& str) noexcept {
+		assign_string(str.data(), str.size());
+	}
+
+	/*dynamic_bitset(N, val)ͬN-1λλ*/
+	constexpr fixed_dynamic_bitset(unsigned long long val) noexcept {
+		for (size_t i = 0; i < N && i < 64; ++i) {
+			if ((val >> i) & 1) {
+				set(N - 1 - i, true);
+			}
+		}
+	}
+
+	/*dynamic_bitsetǰNλλ0*/
+	explicit fixed_dynamic_bitset(const dynamic_bitset& val) noexcept {
+		auto _size = val.size() < N ? val.size() : N;
+		for (size_t i = 0; i < _size; ++i) {
+			if (val[i]) {
+				set(i, true);
+			}
+		}
+	}
+
+	dynamic_bitset to_dynamic_bitset() const {
+		dynamic_bitset _res;
+		_res.resize(N);
+		for (size_t i = 0; i < N; ++i) {
+			if (test(i)) {
+				_res[i] = true;
+			}
+		}
+		return _res;
+	}
+
+	static constexpr size_t size() noexcept {
+		return N;
+	}
+
+	constexpr bool test(size_t index) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (index >= N)
+			throw std::out_of_range("fixed_dynamic_bitset out of range");
+#endif
+		return (__words[index / 64] >> (index % 64)) & 1;
+	}
+
+	constexpr fixed_dynamic_bitset& set(size_t index, bool val = true) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (index >= N)
+			throw std::out_of_range("fixed_dynamic_bitset out of range");
+#endif
+		auto& _word = __words[index / 64];
+		_word = (_word & ~(word(1) << (index % 64))) | (word(val) << (index % 64));
+		return *this;
+	}
+
+	constexpr bit_ref operator[](size_t index) NOEXCEPT_RELEASE {
+		return at(index);
+	}
+
+	constexpr bool operator[](size_t index) const NOEXCEPT_RELEASE {
+		return test(index);
+	}
+
+	constexpr bit_ref at(size_t index) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (index >= N)
+			throw std::out_of_range("fixed_dynamic_bitset out of range");
+#endif
+		return bit_ref(this, index);
+	}
+
+	constexpr bool at(size_t index) const NOEXCEPT_RELEASE {
+		return test(index);
+	}
+
+	constexpr bit_ref front() NOEXCEPT_RELEASE {
+		return at(0);
+	}
+
+	constexpr bool front() const NOEXCEPT_RELEASE {
+		return test(0);
+	}
+
+	constexpr bit_ref back() NOEXCEPT_RELEASE {
+		return at(N - 1);
+	}
+
+	constexpr bool back() const NOEXCEPT_RELEASE {
+		return test(N - 1);
+	}
+
+	constexpr size_t count() const noexcept {
+		size_t _count = 0;
+		for (size_t i = 0; i < word_count; ++i) {
+			_count += dynamic_bitset::popcount(__words[i]);
+		}
+		return _count;
+	}
+
+	constexpr bool any() const noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			if (__words[i] != 0)
+				return true;
+		}
+		return false;
+	}
+
+	constexpr bool none() const noexcept {
+		return !any();
+	}
+
+	constexpr bool is_equal(const fixed_dynamic_bitset& rhs) const noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			if (__words[i] != rhs.__words[i])
+				return false;
+		}
+		return true;
+	}
+
+	constexpr bool operator==(const fixed_dynamic_bitset& rhs) const noexcept {
+		return is_equal(rhs);
+	}
+
+	constexpr bool operator!=(const fixed_dynamic_bitset& rhs) const noexcept {
+		return !is_equal(rhs);
+	}
+
+	/*dynamic_bitset::compareֵͬȽ*/
+	constexpr int compare(const fixed_dynamic_bitset& rhs) const noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			auto _diff = __words[i] ^ rhs.__words[i];
+			if (_diff != 0) {
+				return (__words[i] >> dynamic_bitset::countr_zero(_diff)) & 1 ? 1 : -1;
+			}
+		}
+		return 0;
+	}
+
+	constexpr bool operator<(const fixed_dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) < 0;
+	}
+
+	constexpr bool operator>(const fixed_dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) > 0;
+	}
+
+	constexpr bool operator<=(const fixed_dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) <= 0;
+	}
+
+	constexpr bool operator>=(const fixed_dynamic_bitset& rhs) const noexcept {
+		return compare(rhs) >= 0;
+	}
+
+	constexpr size_t hash() const noexcept {
+		word _seed = 0x9e3779b97f4a7c15ULL ^ N;
+		for (size_t i = 0; i < word_count; ++i) {
+			/*splitmix64Ļϲ*/
+			word _val = __words[i] + _seed + 0x9e3779b97f4a7c15ULL;
+			_val = (_val ^ (_val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			_val = (_val ^ (_val >> 27)) * 0x94d049bb133111ebULL;
+			_seed = _val ^ (_val >> 31);
+		}
+		return size_t(_seed);
+	}
+
+	std::string to_string() const {
+		std::string _res(N, '0');
+		for (size_t i = 0; i < N; ++i) {
+			if (test(i)) {
+				_res[i] = '1';
+			}
+		}
+		return _res;
+	}
+
+	/*dynamic_bitset::to_intͬһλλ*/
+	constexpr size_t to_int() const noexcept {
+		size_t _res = 0;
+		for (size_t i = 0; i < N; ++i) {
+			_res = (_res << 1) | size_t(test(i));
+		}
+		return _res;
+	}
+
+	constexpr fixed_dynamic_bitset operator~() const noexcept {
+		auto _res = *this;
+		for (size_t i = 0; i < word_count; ++i) {
+			_res.__words[i] = ~_res.__words[i];
+		}
+		_res.trim();
+		return _res;
+	}
+
+	constexpr fixed_dynamic_bitset& operator&=(const fixed_dynamic_bitset& rhs) noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			__words[i] &= rhs.__words[i];
+		}
+		return *this;
+	}
+
+	constexpr fixed_dynamic_bitset& operator|=(const fixed_dynamic_bitset& rhs) noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			__words[i] |= rhs.__words[i];
+		}
+		return *this;
+	}
+
+	constexpr fixed_dynamic_bitset& operator^=(const fixed_dynamic_bitset& rhs) noexcept {
+		for (size_t i = 0; i < word_count; ++i) {
+			__words[i] ^= rhs.__words[i];
+		}
+		return *this;
+	}
+
+	constexpr fixed_dynamic_bitset operator&(const fixed_dynamic_bitset& rhs) const noexcept {
+		auto _res = *this;
+		return _res &= rhs;
+	}
+
+	constexpr fixed_dynamic_bitset operator|(const fixed_dynamic_bitset& rhs) const noexcept {
+		auto _res = *this;
+		return _res |= rhs;
+	}
+
+	constexpr fixed_dynamic_bitset operator^(const fixed_dynamic_bitset& rhs) const noexcept {
+		auto _res = *this;
+		return _res ^= rhs;
+	}
+
+	/*
+	* ȹ̶λֵ崦λ
+	* <<n ൱ڳ2^nλ±Сķƶ>>n ൱ڳ2^n
+	* dynamic_bitset<<>>ı䳤
+	*/
+	constexpr fixed_dynamic_bitset& operator<<=(size_t n) noexcept {
+		if (n >= N) {
+			return *this = fixed_dynamic_bitset();
+		}
+		auto _word_shift = n / 64;
+		auto _bit_shift = n % 64;
+		for (size_t i = 0; i < word_count; ++i) {
+			word _low = i + _word_shift < word_count ? __words[i + _word_shift] : 0;
+			word _high = i + _word_shift + 1 < word_count ? __words[i + _word_shift + 1] : 0;
+			__words[i] = _bit_shift == 0 ? _low : (_low >> _bit_shift) | (_high << (64 - _bit_shift));
+		}
+		return *this;
+	}
+
+	constexpr fixed_dynamic_bitset& operator>>=(size_t n) noexcept {
+		if (n >= N) {
+			return *this = fixed_dynamic_bitset();
+		}
+		auto _word_shift = n / 64;
+		auto _bit_shift = n % 64;
+		for (size_t i = word_count; i-- > 0;) {
+			word _high = i >= _word_shift ? __words[i - _word_shift] : 0;
+			word _low = i >= _word_shift + 1 ? __words[i - _word_shift - 1] : 0;
+			__words[i] = _bit_shift == 0 ? _high : (_high << _bit_shift) | (_low >> (64 - _bit_shift));
+		}
+		trim();
+		return *this;
+	}
+
+	constexpr fixed_dynamic_bitset operator<<(size_t n) const noexcept {
+		auto _res = *this;
+		return _res <<= n;
+	}
+
+	constexpr fixed_dynamic_bitset operator>>(size_t n) const noexcept {
+		auto _res = *this;
+		return _res >>= n;
+	}
+
+	constexpr const_iterator begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return const_iterator(this, N);
+	}
+
+	constexpr const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	constexpr const_iterator cend() const noexcept {
+		return end();
+	}
+};
+
+namespace std {
+	template<size_t N>
+	struct hash<fixed_dynamic_bitset<N>> {
+		constexpr size_t operator()(const fixed_dynamic_bitset<N>& val) const noexcept {
+			return val.hash();
+		}
+	};
+}
+
+#undef NOEXCEPT_RELEASE
+#endif // !FIXED_DYNAMIC_BITSET_HPP
@@ -0,0 +1,340 @@
+#pragma once
+#ifndef SEGMENTED_DYNAMIC_BITSET_HPP
+#define SEGMENTED_DYNAMIC_BITSET_HPP
+
+/*
+* ֶδ洢ֻ׷bitsetʺϲĴ󼯺(¼־)
+* ݷֳɹ̶2^24λ(2MBǡһҳ)Ŀ飬ÿһȵdynamic_bitsetĿ¼ֻͷ
+* ʱֻ¿飬ݴӲƣҲdynamic_bitsetʱ¾ݻͬʱڵ
+* size()֮λ0˰ͼҪβ
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined DEBUG || defined _DEBUG
+#define NOEXCEPT_RELEASE
+#else
+#define NOEXCEPT_RELEASE noexcept
+#endif
+
+class segmented_dynamic_bitset
+{
+public:
+	using bit_ref = dynamic_bitset::bit_ref;
+
+	static constexpr size_t chunk_bits() noexcept {
+		return size_t(1) << 24;
+	}
+
+	static constexpr size_t chunk_words() noexcept {
+		return chunk_bits() / 64;
+	}
+
+private:
+	/*Ŀ¼ֻƶ16ֽڵͷ*/
+	std::vector<dynamic_bitset> __chunks;
+	size_t __size{};
+
+	static size_t chunks_of(size_t bits) noexcept {
+		return bits / chunk_bits() + (bits % chunk_bits() != 0);
+	}
+
+	void add_chunk() {
+		__chunks.emplace_back();
+		__chunks.back().resize(chunk_bits());
+	}
+
+	/*[first, last)㣬ͬһ*/
+	void clear_in_chunk(size_t first, size_t last) noexcept {
+		if (first >= last)
+			return;
+		auto& _chunk = __chunks[first / chunk_bits()];
+		auto _first = first % chunk_bits();
+		auto _last = _first + (last - first);
+		auto _first_word = _first / 64;
+		auto _last_word = (_last - 1) / 64;
+		for (auto i = _first_word; i <= _last_word; ++i) {
+			std::uint64_t _mask = ~0ULL;
+			if (i == _first_word) {
+				_mask &= ~0ULL << (_first % 64);
+			}
+			if (i == _last_word && _last % 64 != 0) {
+				_mask &= (1ULL << (_last % 64)) - 1;
+			}
+			_chunk.set_word(i, _chunk.get_word(i) & ~_mask);
+		}
+	}
+
+	/*ĩβ׷valĵnλn <= 64*/
+	void append_word(std::uint64_t val, size_t n) {
+		if (n == 0)
+			return;
+		if (n < 64) {
+			val &= (1ULL << n) - 1;
+		}
+		auto _offset = __size % chunk_bits();
+		if (_offset == 0 && __size / chunk_bits() == __chunks.size()) {
+			add_chunk();
+		}
+		auto& _chunk = __chunks[__size / chunk_bits()];
+		auto _index = _offset / 64;
+		auto _shift = _offset % 64;
+		_chunk.set_word(_index, _chunk.get_word(_index) | (val << _shift));
+		if (_shift + n > 64) {
+			/*֣鳤64ıʱһĵ0*/
+			if (_index + 1 == chunk_words()) {
+				add_chunk();
+				__chunks.back().set_word(0, val >> (64 - _shift));
+			}
+			else {
+				_chunk.set_word(_index + 1, val >> (64 - _shift));
+			}
+		}
+		__size += n;
+	}
+
+	template<class Op>
+	segmented_dynamic_bitset& combine_assign(const segmented_dynamic_bitset& rhs, Op op) {
+		if (rhs.__size > __size) {
+			resize(rhs.__size);
+		}
+		for (size_t i = 0; i < rhs.__chunks.size(); ++i) {
+			op(__chunks[i], rhs.__chunks[i]);
+		}
+		return *this;
+	}
+
+public:
+	segmented_dynamic_bitset() noexcept {}
+
+	/*ָƣһͨget_wordȥЧλ*/
+	explicit segmented_dynamic_bitset(const dynamic_bitset& val) {
+		auto _size = val.size();
+		auto _full_bytes = _size / 64 * 8;
+		__chunks.reserve(chunks_of(_size));
+		for (size_t i = 0; i < chunks_of(_size); ++i) {
+			add_chunk();
+			auto _first = i * chunk_bits() / 8;
+			auto _bytes = std::min(chunk_bits() / 8, _full_bytes - std::min(_full_bytes, _first));
+			if (_bytes != 0) {
+				std::memcpy(__chunks[i].data(), val.data() + _first, _bytes);
+			}
+		}
+		if (_size % 64 != 0) {
+			auto _last = _size / 64;
+			__chunks[_last / chunk_words()].set_word(_last % chunk_words(), val.get_word(_last));
+		}
+		__size = _size;
+	}
+
+	explicit segmented_dynamic_bitset(const std::string& val)
+		:segmented_dynamic_bitset(dynamic_bitset(val)) {}
+
+	/*ƴΪ洢dynamic_bitset*/
+	dynamic_bitset to_dynamic_bitset() const {
+		dynamic_bitset _res;
+		_res.resize(__size);
+		auto _bytes = __size / 8 + (__size % 8 != 0);
+		for (size_t i = 0; i < __chunks.size(); ++i) {
+			auto _first = i * chunk_bits() / 8;
+			std::memcpy(_res.data() + _first, __chunks[i].data(), std::min(chunk_bits() / 8, _bytes - _first));
+		}
+		return _res;
+	}
+
+	size_t size() const noexcept {
+		return __size;
+	}
+
+	bool empty() const noexcept {
+		return __size == 0;
+	}
+
+	/*ѷλǿ鳤*/
+	size_t capacity() const noexcept {
+		return __chunks.size() * chunk_bits();
+	}
+
+	size_t chunk_count() const noexcept {
+		return __chunks.size();
+	}
+
+	/*i飬Ϊchunk_bits()size()֮λΪ0԰鲢д*/
+	const dynamic_bitset& chunk(size_t i) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (i >= __chunks.size())
+			throw std::out_of_range("segmented_dynamic_bitset out of range");
+#endif
+		return __chunks[i];
+	}
+
+	bool test(size_t index) const NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (index >= __size)
+			throw std::out_of_range("segmented_dynamic_bitset out of range");
+#endif
+		return __chunks[index / chunk_bits()][index % chunk_bits()];
+	}
+
+	void set(size_t index, bool val = true) NOEXCEPT_RELEASE {
+		(*this)[index] = val;
+	}
+
+	bit_ref operator[](size_t index) NOEXCEPT_RELEASE {
+#if defined DEBUG || defined _DEBUG
+		if (index >= __size)
+			throw std::out_of_range("segmented_dynamic_bitset out of range");
+#endif
+		return __chunks[index / chunk_bits()][index % chunk_bits()];
+	}
+
+	bool operator[](size_t index) const NOEXCEPT_RELEASE {
+		return test(index);
+	}
+
+	void push_back(bool val) {
+		append_word(val, 1);
+	}
+
+	void push_back(size_t n, bool val) {
+		for (; n >= 64; n -= 64) {
+			append_word(val ? ~0ULL : 0, 64);
+		}
+		append_word(val ? ~0ULL : 0, n);
+	}
+
+	/*ĩβֶʱmemcpyУƴ*/
+	void push_back(const dynamic_bitset& rhs) {
+		auto _size = rhs.size();
+		size_t _done = 0;
+		while (__size % 64 == 0 && _size - _done >= 64) {
+			if (__size % chunk_bits() == 0 && __size / chunk_bits() == __chunks.size()) {
+				add_chunk();
+			}
+			auto _offset = __size % chunk_bits();
+			auto _bits = std::min(chunk_bits() - _offset, (_size - _done) / 64 * 64);
+			std::memcpy(__chunks[__size / chunk_bits()].data() + _offset / 8, rhs.data() + _done / 8, _bits / 8);
+			__size += _bits;
+			_done += _bits;
+		}
+		for (; _done < _size; _done += 64) {
+			append_word(rhs.get_word(_done / 64), std::min<size_t>(64, _size - _done));
+		}
+	}
+
+	/*ʱλΪ0ֻڿʱ䣻СʱͷŶĿ鲢βԱֲ*/
+	void resize(size_t new_size) {
+		if (new_size < __size) {
+			__chunks.resize(chunks_of(new_size));
+			if (new_size % chunk_bits() != 0) {
+				auto _end = std::min(__size, __chunks.size() * chunk_bits());
+				clear_in_chunk(new_size, _end);
+			}
+		}
+		else {
+			while (__chunks.size() < chunks_of(new_size)) {
+				add_chunk();
+			}
+		}
+		__size = new_size;
+	}
+
+	void pop_back(size_t count = 1) {
+		resize(__size - count);
+	}
+
+	void clear() noexcept {
+		__chunks.clear();
+		__size = 0;
+	}
+
+	/*popcount*/
+	size_t count() const noexcept {
+		size_t _count = 0;
+		for (const auto& _chunk : __chunks) {
+			_count += _chunk.count();
+		}
+		return _count;
+	}
+
+	bool any() const noexcept {
+		for (const auto& _chunk : __chunks) {
+			for (size_t i = 0; i < chunk_words(); ++i) {
+				if (_chunk.get_word(i) != 0)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	bool none() const noexcept {
+		return !any();
+	}
+
+	size_t intersection_count(const segmented_dynamic_bitset& rhs) const noexcept {
+		size_t _count = 0;
+		auto _chunks = std::min(__chunks.size(), rhs.__chunks.size());
+		for (size_t i = 0; i < _chunks; ++i) {
+			_count += __chunks[i].intersection_count(rhs.__chunks[i]);
+		}
+		return _count;
+	}
+
+	/*ȡ߽ϴߣԭ*/
+	segmented_dynamic_bitset& operator&=(const segmented_dynamic_bitset& rhs) {
+		combine_assign(rhs, [](dynamic_bitset& l, const dynamic_bitset& r) { l &= r; });
+		/*rhs֮Ŀȫ*/
+		for (auto i = rhs.__chunks.size(); i < __chunks.size(); ++i) {
+			clear_in_chunk(i * chunk_bits(), std::min(__size, (i + 1) * chunk_bits()));
+		}
+		return *this;
+	}
+
+	segmented_dynamic_bitset& operator|=(const segmented_dynamic_bitset& rhs) {
+		return combine_assign(rhs, [](dynamic_bitset& l, const dynamic_bitset& r) { l |= r; });
+	}
+
+	segmented_dynamic_bitset& operator^=(const segmented_dynamic_bitset& rhs) {
+		return combine_assign(rhs, [](dynamic_bitset& l, const dynamic_bitset& r) { l ^= r; });
+	}
+
+	segmented_dynamic_bitset operator&(const segmented_dynamic_bitset& rhs) const {
+		auto _res(*this);
+		_res &= rhs;
+		return _res;
+	}
+
+	segmented_dynamic_bitset operator|(const segmented_dynamic_bitset& rhs) const {
+		auto _res(*this);
+		_res |= rhs;
+		return _res;
+	}
+
+	segmented_dynamic_bitset operator^(const segmented_dynamic_bitset& rhs) const {
+		auto _res(*this);
+		_res ^= rhs;
+		return _res;
+	}
+
+	bool operator==(const segmented_dynamic_bitset& rhs) const noexcept {
+		return __size == rhs.__size && __chunks == rhs.__chunks;
+	}
+
+	bool operator!=(const segmented_dynamic_bitset& rhs) const noexcept {
+		return !(*this == rhs);
+	}
+
+	void swap(segmented_dynamic_bitset& rhs) noexcept {
+		__chunks.swap(rhs.__chunks);
+		std::swap(__size, rhs.__size);
+	}
+};
+
+#undef NOEXCEPT_RELEASE
+#endif // !SEGMENTED_DYNAMIC_BITSET_HPP
@@ -0,0 +1,366 @@
+#pragma once
+#ifndef SHARED_DYNAMIC_BITSET_HPP
+#define SHARED_DYNAMIC_BITSET_HPP
+
+/*
+* дʱƵdynamic_bitsetֻüһ޸ʱŸ
+* constbit_ref͵󶨵ǱݣȡḴƣͨдʱŵdetach()
+* ֻĳ߲Ըһݣ֮󿽱ȥĿҲᱻ֮ǰȡõbit_refĵ
+*/
+
+#include "dynamic_bitset.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+class shared_dynamic_bitset
+{
+public:
+	using const_iterator = dynamic_bitset::const_iterator;
+
+	/*ȡget()ֻиֵʱdetach()*/
+	class bit_ref {
+	private:
+		shared_dynamic_bitset* __bind;
+		size_t __index;
+	public:
+		bit_ref(shared_dynamic_bitset* bind, size_t index) noexcept :__bind(bind), __index(index) {}
+
+		bit_ref(const bit_ref& rhs) noexcept = default;
+
+		bit_ref& operator=(bool val) {
+			__bind->detach()[__index] = val;
+			return *this;
+		}
+
+		bit_ref& operator=(const bit_ref& rhs) {
+			return *this = bool(rhs);
+		}
+
+		operator bool() const {
+			return __bind->get()[__index];
+		}
+
+		size_t index() const noexcept {
+			return __index;
+		}
+	};
+
+	/*õõbit_refᴥ*/
+	class iterator {
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = bit_ref;
+	private:
+		shared_dynamic_bitset* __bind;
+		size_t __index;
+	public:
+		iterator() noexcept :__bind(), __index() {}
+
+		iterator(shared_dynamic_bitset* bind, size_t index) noexcept :__bind(bind), __index(index) {}
+
+		bit_ref operator*() const noexcept {
+			return bit_ref(__bind, __index);
+		}
+
+		bit_ref operator[](difference_type off) const noexcept {
+			return bit_ref(__bind, __index + off);
+		}
+
+		iterator& operator++() noexcept {
+			++__index;
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			auto _tmp = *this;
+			++*this;
+			return _tmp;
+		}
+
+		iterator& operator--() noexcept {
+			--__index;
+			return *this;
+		}
+
+		iterator operator--(int) noexcept {
+			auto _tmp = *this;
+			--*this;
+			return _tmp;
+		}
+
+		iterator& operator+=(difference_type off) noexcept {
+			__index += off;
+			return *this;
+		}
+
+		iterator operator+(difference_type off) const noexcept {
+			return iterator(__bind, __index + off);
+		}
+
+		iterator& operator-=(difference_type off) noexcept {
+			__index -= off;
+			return *this;
+		}
+
+		iterator operator-(difference_type off) const noexcept {
+			return iterator(__bind, __index - off);
+		}
+
+		difference_type operator-(const iterator& rhs) const noexcept {
+			return difference_type(__index - rhs.__index);
+		}
+
+		bool operator==(const iterator& rhs) const noexcept {
+			return __bind == rhs.__bind && __index == rhs.__index;
+		}
+
+		bool operator!=(const iterator& rhs) const noexcept {
+			return !(*this == rhs);
+		}
+
+		bool operator<(const iterator& rhs) const noexcept {
+			return __index < rhs.__index;
+		}
+
+		bool operator>(const iterator& rhs) const noexcept {
+			return rhs < *this;
+		}
+
+		bool operator<=(const iterator& rhs) const noexcept {
+			return !(rhs < *this);
+		}
+
+		bool operator>=(const iterator& rhs) const noexcept {
+			return !(*this < rhs);
+		}
+	};
+
+private:
+	/*ָʾյbitsetĬϹ첻ڴ*/
+	std::shared_ptr<dynamic_bitset> __ptr;
+
+	static const dynamic_bitset& empty() noexcept {
+		static const dynamic_bitset _empty;
+		return _empty;
+	}
+
+	/*޸ǰãʱһ˽*/
+	dynamic_bitset& detach() {
+		if (!__ptr) {
+			__ptr = std::make_shared<dynamic_bitset>();
+		}
+		else if (__ptr.use_count() != 1) {
+			__ptr = std::make_shared<dynamic_bitset>(*__ptr);
+		}
+		else {
+			/*
+			* use_count()relaxedȡ߳ͷһʱĵݼrelease壬
+			* acquireϱ֤֮ǰݵĶȡڱ̵߳д֮ǰ
+			*/
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		return *__ptr;
+	}
+
+public:
+	shared_dynamic_bitset() noexcept {}
+
+	shared_dynamic_bitset(const shared_dynamic_bitset& rhs) noexcept = default;
+
+	shared_dynamic_bitset(shared_dynamic_bitset&& rhs) noexcept = default;
+
+	shared_dynamic_bitset(const dynamic_bitset& val)
+		:__ptr(std::make_shared<dynamic_bitset>(val)) {}
+
+	shared_dynamic_bitset(dynamic_bitset&& val)
+		:__ptr(std::make_shared<dynamic_bitset>(std::move(val))) {}
+
+	shared_dynamic_bitset(const std::string& val)
+		:__ptr(std::make_shared<dynamic_bitset>(val)) {}
+
+	shared_dynamic_bitset& operator=(const shared_dynamic_bitset& rhs) noexcept = default;
+
+	shared_dynamic_bitset& operator=(shared_dynamic_bitset&& rhs) noexcept = default;
+
+	/*ֻͼᴥ*/
+	const dynamic_bitset& get() const noexcept {
+		return __ptr ? *__ptr : empty();
+	}
+
+	/*дͼᴥ*/
+	dynamic_bitset& mutate() {
+		return detach();
+	}
+
+	/*ͬһݵĶδʱΪ0*/
+	long use_count() const noexcept {
+		return __ptr.use_count();
+	}
+
+	bool is_shared() const noexcept {
+		return __ptr.use_count() > 1;
+	}
+
+	size_t size() const noexcept {
+		return get().size();
+	}
+
+	const dynamic_bitset::bit_ref operator[](size_t index) const {
+		return get()[index];
+	}
+
+	bit_ref operator[](size_t index) noexcept {
+		return bit_ref(this, index);
+	}
+
+	const dynamic_bitset::bit_ref at(size_t index) const {
+		return get().at(index);
+	}
+
+	bit_ref at(size_t index) noexcept {
+		return bit_ref(this, index);
+	}
+
+	const dynamic_bitset::bit_ref front() const {
+		return get().front();
+	}
+
+	const dynamic_bitset::bit_ref back() const {
+		return get().back();
+	}
+
+	void resize(size_t new_size) {
+		detach().resize(new_size);
+	}
+
+	void push_back(bool val) {
+		detach().push_back(val);
+	}
+
+	void pop_back(size_t count = 1) {
+		detach().pop_back(count);
+	}
+
+	/*ݣֱӷԹݵ*/
+	void clear() noexcept {
+		__ptr.reset();
+	}
+
+	shared_dynamic_bitset& operator&=(const dynamic_bitset& rhs) {
+		detach() &= rhs;
+		return *this;
+	}
+
+	shared_dynamic_bitset& operator|=(const dynamic_bitset& rhs) {
+		detach() |= rhs;
+		return *this;
+	}
+
+	shared_dynamic_bitset& operator^=(const dynamic_bitset& rhs) {
+		detach() ^= rhs;
+		return *this;
+	}
+
+	shared_dynamic_bitset& operator&=(const shared_dynamic_bitset& rhs) {
+		return *this &= rhs.get();
+	}
+
+	shared_dynamic_bitset& operator|=(const shared_dynamic_bitset& rhs) {
+		return *this |= rhs.get();
+	}
+
+	shared_dynamic_bitset& operator^=(const shared_dynamic_bitset& rhs) {
+		return *this ^= rhs.get();
+	}
+
+	shared_dynamic_bitset operator&(const shared_dynamic_bitset& rhs) const {
+		return shared_dynamic_bitset(get() & rhs.get());
+	}
+
+	shared_dynamic_bitset operator|(const shared_dynamic_bitset& rhs) const {
+		return shared_dynamic_bitset(get() | rhs.get());
+	}
+
+	shared_dynamic_bitset operator^(const shared_dynamic_bitset& rhs) const {
+		return shared_dynamic_bitset(get() ^ rhs.get());
+	}
+
+	shared_dynamic_bitset operator~() const {
+		return shared_dynamic_bitset(~get());
+	}
+
+	bool operator==(const shared_dynamic_bitset& rhs) const noexcept {
+		return __ptr == rhs.__ptr || get() == rhs.get();
+	}
+
+	bool operator!=(const shared_dynamic_bitset& rhs) const noexcept {
+		return !(*this == rhs);
+	}
+
+	bool operator<(const shared_dynamic_bitset& rhs) const noexcept {
+		return get() < rhs.get();
+	}
+
+	int compare(const shared_dynamic_bitset& rhs) const noexcept {
+		return get().compare(rhs.get());
+	}
+
+	size_t hash() const noexcept {
+		return get().hash();
+	}
+
+	std::string to_string() const {
+		return get().to_string();
+	}
+
+	size_t to_int() const noexcept {
+		return get().to_int();
+	}
+
+	void swap(shared_dynamic_bitset& rhs) noexcept {
+		__ptr.swap(rhs.__ptr);
+	}
+
+	const_iterator begin() const noexcept {
+		return get().begin();
+	}
+
+	const_iterator end() const noexcept {
+		return get().end();
+	}
+
+	const_iterator cbegin() const noexcept {
+		return get().cbegin();
+	}
+
+	const_iterator cend() const noexcept {
+		return get().cend();
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, 0);
+	}
+
+	iterator end() noexcept {
+		return iterator(this, size());
+	}
+};
+
+namespace std {
+	template<>
+	struct hash<shared_dynamic_bitset> {
+		size_t operator()(const shared_dynamic_bitset& val) const noexcept {
+			return val.hash();
+		}
+	};
+}
+
+#endif // !SHARED_DYNAMIC_BITSET_HPP
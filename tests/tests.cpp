@@ -0,0 +1,720 @@
+/*
+* ȷԲԣѸּ/SIMDʵλʵֶԱ
+* λеĲοʵstd::stringiַӦiλ
+* ÷dynamic_bitset_testsʧʱط0
+*/
+
+#include "bit_matrix.hpp"
+#include "bit_stream.hpp"
+#include "blocked_bloom_filter.hpp"
+#include "counted_dynamic_bitset.hpp"
+#include "dynamic_bitset.hpp"
+#include "fingerprint_collection.hpp"
+#include "fixed_dynamic_bitset.hpp"
+#include "segmented_dynamic_bitset.hpp"
+#include "shared_dynamic_bitset.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*ReleaseassertЧԼ鲢*/
+#define CHECK(expr) \
+	do { \
+		if (!(expr)) { \
+			++failures; \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+		} \
+	} while (0)
+
+/*fixed_dynamic_bitsetŵڳʽĳɷconstexprʱʧ*/
+namespace fixed_constexpr {
+	using bits8 = fixed_dynamic_bitset<8>;
+	using bits100 = fixed_dynamic_bitset<100>;
+
+	constexpr bits8 a("11010000");
+	constexpr bits8 b("10011001");
+	static_assert(a.test(0) && a.test(1) && !a.test(2) && a.test(3), "literal construction");
+	static_assert(bits8(5ULL) == bits8("00000101"), "integer construction");
+	static_assert((a | b) == bits8("11011001"), "operator|");
+	static_assert((a & b) == bits8("10010000"), "operator&");
+	static_assert((a ^ b) == bits8("01001001"), "operator^");
+	static_assert((a << 2) == bits8("01000000"), "operator<<");
+	static_assert((a >> 3) == bits8("00011010"), "operator>>");
+	static_assert(a.to_int() == 208, "to_int");
+	static_assert(bits100("1").set(99).test(99), "set");
+	/*C++20֮ǰMSVCpopcount/countr_zeroconstexpr*/
+#if !defined _MSC_VER || defined __clang__ || defined __cpp_lib_is_constant_evaluated
+	static_assert(a.count() == 3 && (~a).count() == 5, "count");
+	static_assert(bits100("1").set(99).count() == 2, "count across words");
+	static_assert(a.compare(b) > 0 && b.compare(a) < 0 && a.compare(a) == 0, "compare");
+	static_assert(bits100("0").set(80) < bits100("0").set(70), "compare across words");
+#endif
+}
+
+namespace {
+	size_t failures = 0;
+
+	std::mt19937_64 rng(20240601);
+
+	std::string random_bits(size_t n) {
+		std::string _res(n, '0');
+		for (auto& c : _res) {
+			c = char('0' + (rng() & 1));
+		}
+		return _res;
+	}
+
+	/*ȡϣͱȽֻǰsize()λsize()Ĳλsso/Ѵ洢ʽӰ*/
+	void test_equality() {
+		dynamic_bitset _a(std::string("1111111111")), _b(std::string("1111111100"));
+		_a.pop_back(2);
+		_b.pop_back(2);
+		CHECK(_a == _b && _a.hash() == _b.hash() && _a.compare(_b) == 0);
+		for (int it = 0; it < 500; ++it) {
+			auto _ref = random_bits(rng() % 200);
+			dynamic_bitset _sso(_ref);
+			/*չأĲλ*/
+			dynamic_bitset _heap(_ref + random_bits(1000));
+			_heap.resize(_ref.size());
+			CHECK(_sso == _heap);
+			CHECK(_sso.hash() == _heap.hash());
+			CHECK(std::hash<dynamic_bitset>()(_sso) == std::hash<dynamic_bitset>()(_heap));
+			CHECK(_sso.compare(_heap) == 0);
+		}
+		for (int it = 0; it < 2000; ++it) {
+			auto _lhs = random_bits(rng() % 300);
+			auto _rhs = rng() % 3 == 0 ? _lhs : random_bits(rng() % 300);
+			if (rng() % 2 && !_lhs.empty()) {
+				/*ֻĩβһλͬ*/
+				_rhs = _lhs;
+				_rhs.back() = _rhs.back() == '1' ? '0' : '1';
+			}
+			dynamic_bitset _lhs_bits(_lhs), _rhs_bits(_rhs);
+			auto _expected = _lhs.compare(_rhs);
+			_expected = (_expected > 0) - (_expected < 0);
+			CHECK(_lhs_bits.compare(_rhs_bits) == _expected);
+			CHECK((_lhs_bits < _rhs_bits) == (_lhs < _rhs));
+			CHECK((_lhs_bits == _rhs_bits) == (_lhs == _rhs));
+		}
+	}
+
+	/*ƶֵͷԭڴ(ASanй©ᱨ)assignͿֵ㹻ʱ·*/
+	void test_copy_move_swap() {
+		for (int it = 0; it < 300; ++it) {
+			auto _lhs_ref = random_bits(rng() % 500);
+			auto _rhs_ref = random_bits(rng() % 500);
+			dynamic_bitset _lhs(_lhs_ref), _rhs(_rhs_ref);
+			_lhs.swap(_rhs);
+			CHECK(_lhs.to_string() == _rhs_ref && _rhs.to_string() == _lhs_ref);
+			_lhs = std::move(_rhs);
+			CHECK(_lhs.to_string() == _lhs_ref && _rhs.size() == 0);
+			_rhs.push_back(true);
+			CHECK(_rhs.to_string() == "1");
+			dynamic_bitset _moved(std::move(_lhs));
+			CHECK(_moved.to_string() == _lhs_ref && _lhs.size() == 0);
+		}
+		dynamic_bitset _big(random_bits(1000));
+		auto _cap = _big.capacity();
+		dynamic_bitset _small(std::string("101"));
+		_big.assign(_small);
+		CHECK(_big.capacity() == _cap && _big.to_string() == "101");
+		dynamic_bitset _other(random_bits(900));
+		_big = _other;
+		CHECK(_big.capacity() == _cap && _big == _other);
+		_big = std::move(_big);
+		CHECK(_big == _other);
+		_big.swap(_big);
+		CHECK(_big == _other);
+	}
+
+	/*϶̵һ룬ĩβвλӦ벹0std::stringλȽһ*/
+	void test_set_relations() {
+		for (int it = 0; it < 2000; ++it) {
+			auto _lhs_ref = random_bits(rng() % 400);
+			auto _rhs_ref = random_bits(rng() % 400);
+			/*ƫӼϵ򼸺false*/
+			if (rng() % 2) {
+				for (size_t i = 0; i < _lhs_ref.size(); ++i) {
+					if (i >= _rhs_ref.size() || _rhs_ref[i] == '0') {
+						_lhs_ref[i] = rng() % 8 == 0 ? '1' : '0';
+					}
+				}
+			}
+			dynamic_bitset _lhs(_lhs_ref + std::string(70, '1')), _rhs(_rhs_ref + std::string(70, '1'));
+			_lhs.pop_back(70);
+			_rhs.pop_back(70);
+			auto _size = std::max(_lhs_ref.size(), _rhs_ref.size());
+			_lhs_ref.resize(_size, '0');
+			_rhs_ref.resize(_size, '0');
+			bool _subset = true, _proper = false, _intersects = false;
+			size_t _count = 0;
+			for (size_t i = 0; i < _size; ++i) {
+				bool _l = _lhs_ref[i] == '1', _r = _rhs_ref[i] == '1';
+				_subset = _subset && (!_l || _r);
+				_proper = _proper || (_r && !_l);
+				_intersects = _intersects || (_l && _r);
+				_count += _l && _r;
+			}
+			CHECK(_lhs.is_subset_of(_rhs) == _subset);
+			CHECK(_lhs.is_proper_subset_of(_rhs) == (_subset && _proper));
+			CHECK(_lhs.intersects(_rhs) == _intersects);
+			CHECK(_lhs.is_disjoint(_rhs) == !_intersects);
+			CHECK(_lhs.intersection_count(_rhs) == _count);
+			CHECK(intersection_count(_rhs, _lhs) == _count);
+		}
+	}
+
+	/*ڽdynamic_bitsetһ*/
+	template<size_t N>
+	void test_fixed() {
+		for (int it = 0; it < 200; ++it) {
+			auto _lhs_ref = random_bits(N), _rhs_ref = random_bits(N);
+			fixed_dynamic_bitset<N> _lhs(_lhs_ref), _rhs(_rhs_ref);
+			dynamic_bitset _lhs_dynamic(_lhs_ref), _rhs_dynamic(_rhs_ref);
+			CHECK(_lhs.to_string() == _lhs_ref);
+			CHECK(_lhs.count() == _lhs_dynamic.count());
+			CHECK(_lhs.compare(_rhs) == _lhs_dynamic.compare(_rhs_dynamic));
+			CHECK(_lhs.to_int() == _lhs_dynamic.to_int());
+			CHECK((_lhs | _rhs).to_string() == (_lhs_dynamic | _rhs_dynamic).to_string());
+			CHECK((_lhs & _rhs).to_string() == (_lhs_dynamic & _rhs_dynamic).to_string());
+			CHECK((_lhs ^ _rhs).to_string() == (_lhs_dynamic ^ _rhs_dynamic).to_string());
+			CHECK((~_lhs).to_string() == (~_lhs_dynamic).to_string());
+			auto _n = size_t(rng() % (N + 1));
+			CHECK((_lhs << _n).to_string() == _lhs_ref.substr(_n) + std::string(_n, '0'));
+			CHECK((_lhs >> _n).to_string() == std::string(_n, '0') + _lhs_ref.substr(0, N - _n));
+			CHECK(_lhs.to_dynamic_bitset() == _lhs_dynamic);
+			CHECK(fixed_dynamic_bitset<N>(_lhs_dynamic) == _lhs);
+		}
+	}
+
+	/*λƶֱ߽ɾstd::stringԱ*/
+	void test_insert_erase() {
+		for (int it = 0; it < 2000; ++it) {
+			auto _ref = random_bits(rng() % 400);
+			dynamic_bitset _bits(_ref);
+			auto _pos = rng() % (_ref.size() + 1);
+			switch (rng() % 3) {
+			case 0: {
+				auto _n = rng() % 200;
+				bool _val = rng() & 1;
+				_bits.insert(_pos, _n, _val);
+				_ref.insert(_pos, _n, _val ? '1' : '0');
+				break;
+			}
+			case 1: {
+				auto _other = random_bits(rng() % 200);
+				_bits.insert(_pos, dynamic_bitset(_other));
+				_ref.insert(_pos, _other);
+				break;
+			}
+			default: {
+				auto _last = _pos + rng() % (_ref.size() - _pos + 1);
+				_bits.erase(_pos, _last);
+				_ref.erase(_pos, _last - _pos);
+				break;
+			}
+			}
+			CHECK(_bits.to_string() == _ref);
+			/*ɾչߵľλ0*/
+			_bits.resize(_bits.size() + 70);
+			CHECK(_bits.to_string() == _ref + std::string(70, '0'));
+		}
+		/**/
+		auto _ref = random_bits(150);
+		dynamic_bitset _bits(_ref);
+		_bits.insert(37, _bits);
+		_ref.insert(37, _ref);
+		CHECK(_bits.to_string() == _ref);
+	}
+
+	/*n·㣺λͳÿλ1ĸ*/
+	void test_n_way() {
+		for (int it = 0; it < 300; ++it) {
+			auto _n = size_t(rng() % 10);
+			std::vector<std::string> _refs;
+			std::vector<dynamic_bitset> _bits;
+			size_t _max = 0;
+			for (size_t i = 0; i < _n; ++i) {
+				_refs.push_back(random_bits(rng() % (it % 10 == 0 ? 20000 : 300)));
+				_max = std::max(_max, _refs.back().size());
+			}
+			for (auto& s : _refs) {
+				_bits.emplace_back(s);
+			}
+			std::vector<const dynamic_bitset*> _ptrs;
+			for (auto& b : _bits) {
+				_ptrs.push_back(&b);
+			}
+			auto _k = size_t(rng() % (_n + 2));
+			dynamic_bitset _and(std::string(500, '1')), _or, _threshold;
+			dynamic_bitset::intersect_all(_and, _ptrs.data(), _n);
+			dynamic_bitset::union_all(_or, _ptrs.data(), _n);
+			dynamic_bitset::threshold(_threshold, _k, _ptrs.data(), _n);
+			CHECK(_and.size() == _max && _or.size() == _max && _threshold.size() == _max);
+			if (_and.size() != _max || _or.size() != _max || _threshold.size() != _max)
+				continue;
+			for (size_t j = 0; j < _max; ++j) {
+				size_t _count = 0;
+				for (auto& s : _refs) {
+					_count += j < s.size() && s[j] == '1';
+				}
+				CHECK(bool(_and[j]) == (_n > 0 && _count == _n));
+				CHECK(bool(_or[j]) == (_count > 0));
+				CHECK(bool(_threshold[j]) == (_count >= _k));
+			}
+			/*֮һ*/
+			if (_n > 0) {
+				dynamic_bitset::union_all(_bits[0], _ptrs.data(), _n);
+				CHECK(_bits[0] == _or);
+			}
+		}
+	}
+
+	void test_indices() {
+		for (int it = 0; it < 300; ++it) {
+			auto _ref = random_bits(rng() % 3000);
+			dynamic_bitset _bits(_ref);
+			std::vector<std::uint32_t> _expected;
+			for (size_t i = 0; i < _ref.size(); ++i) {
+				if (_ref[i] == '1') {
+					_expected.push_back(std::uint32_t(i));
+				}
+			}
+			std::vector<std::uint32_t> _indices;
+			_bits.to_indices(_indices);
+			CHECK(_indices == _expected);
+			auto _back = dynamic_bitset::from_indices(_indices.data(), _indices.size(), _ref.size());
+			CHECK(_back == _bits);
+		}
+	}
+
+	bit_matrix random_matrix(size_t rows, size_t cols, size_t density) {
+		bit_matrix _res(rows, cols);
+		for (size_t i = 0; i < rows; ++i) {
+			for (size_t j = 0; j < cols; ++j) {
+				if (rng() % density == 0) {
+					_res.set(i, j);
+				}
+			}
+		}
+		return _res;
+	}
+
+	bit_matrix naive_multiply(const bit_matrix& a, const bit_matrix& b) {
+		bit_matrix _res(a.rows(), b.cols());
+		for (size_t i = 0; i < a.rows(); ++i) {
+			for (size_t j = 0; j < b.cols(); ++j) {
+				bool _sum = false;
+				for (size_t k = 0; k < a.cols(); ++k) {
+					_sum ^= a.get(i, k) && b.get(k, j);
+				}
+				_res.set(i, j, _sum);
+			}
+		}
+		return _res;
+	}
+
+	/*Ԫĸ˹Ԫ*/
+	size_t naive_rank(bit_matrix a) {
+		size_t _rank = 0;
+		for (size_t c = 0; c < a.cols() && _rank < a.rows(); ++c) {
+			auto _pivot = _rank;
+			while (_pivot < a.rows() && !a.get(_pivot, c)) {
+				++_pivot;
+			}
+			if (_pivot == a.rows())
+				continue;
+			a.swap_rows(_pivot, _rank);
+			for (size_t i = 0; i < a.rows(); ++i) {
+				if (i != _rank && a.get(i, c)) {
+					a.xor_row(i, _rank);
+				}
+			}
+			++_rank;
+		}
+		return _rank;
+	}
+
+	/*M4RM˷M4RIԪ*/
+	void test_bit_matrix() {
+		for (int it = 0; it < 60; ++it) {
+			auto _m = 1 + rng() % 150, _n = 1 + rng() % 150, _p = 1 + rng() % 100;
+			auto _a = random_matrix(_m, _n, 1 + rng() % 4);
+			auto _b = random_matrix(_n, _p, 2);
+			CHECK(_a * _b == naive_multiply(_a, _b));
+			auto _t = _a.transpose();
+			CHECK(_t.rows() == _n && _t.cols() == _m && _t.transpose() == _a);
+			auto _e = _a;
+			auto _rank = _e.eliminate(true);
+			CHECK(_rank == naive_rank(_a));
+			CHECK(_rank == _a.rank());
+			/*򻯽ΣÿԪֻԪ1֮ȫΪ0*/
+			size_t _row = 0;
+			for (size_t c = 0; c < _n && _row < _rank; ++c) {
+				if (!_e.get(_row, c))
+					continue;
+				for (size_t i = 0; i < _m; ++i) {
+					CHECK(_e.get(i, c) == (i == _row));
+				}
+				++_row;
+			}
+			for (size_t i = _rank; i < _m; ++i) {
+				for (size_t c = 0; c < _n; ++c) {
+					CHECK(!_e.get(i, c));
+				}
+			}
+		}
+		auto _x = random_matrix(200, 200, 2);
+		CHECK(bit_matrix::identity(200) * _x == _x);
+		bit_matrix _moved(std::move(_x));
+		CHECK(_x.rows() == 0 && _x.cols() == 0 && _moved.rows() == 200);
+	}
+
+	void test_shared_detach() {
+		shared_dynamic_bitset _a(std::string(300, '0'));
+		auto _b = _a;
+		CHECK(_a.use_count() == 2 && &_a.get() == &_b.get());
+		_b[5] = true;
+		CHECK(_a.use_count() == 1 && _b.use_count() == 1);
+		CHECK(!_a[5] && _b[5]);
+		auto _c = _b;
+		_c.resize(1000);
+		CHECK(_b.size() == 300 && _c.size() == 1000 && _b[5]);
+		_c &= _a;
+		CHECK(_c.to_string() == std::string(1000, '0'));
+		/*Ψһԭ޸ģ*/
+		auto _data = &_b.get();
+		_b[6] = true;
+		CHECK(&_b.get() == _data);
+		/*constĶȡͱ*/
+		auto _reader = _b;
+		CHECK(_reader[5] && _b.use_count() == 2);
+		size_t _count = 0;
+		for (auto _bit : _reader) {
+			_count += bool(_bit);
+		}
+		CHECK(_count == 2 && _b.use_count() == 2);
+		/*ȡõbit_refдʱŸƣӰ֮󿽱Ŀ*/
+		auto _ref = _b[0];
+		auto _snapshot = _b;
+		_ref = true;
+		CHECK(_b[0] && !_snapshot[0] && _snapshot.use_count() == 2);
+		*(_reader.begin() + 9) = true;
+		CHECK(_reader[9] && !_snapshot[9]);
+		shared_dynamic_bitset _empty;
+		_empty.push_back(true);
+		CHECK(_empty.size() == 1 && _empty[0]);
+	}
+
+	/*롢gammaһԪ뽻д˳*/
+	void test_bit_stream() {
+		for (size_t _prefix : { 0, 5, 64, 130 }) {
+			dynamic_bitset _bits;
+			for (size_t i = 0; i < _prefix; ++i) {
+				_bits.push_back(i % 3 == 0);
+			}
+			std::vector<std::pair<std::uint64_t, size_t>> _codes;
+			std::vector<std::uint64_t> _gammas;
+			std::vector<size_t> _unaries;
+			{
+				auto _before = _bits.to_string();
+				bit_writer _writer(_bits);
+				/*writerıoutдɼ*/
+				CHECK(_bits.to_string() == _before);
+				_writer.write(~std::uint64_t(0), 64);
+				CHECK(_bits.size() == _prefix + 64 - _prefix % 64);
+				CHECK(_bits.to_string().compare(0, _prefix, _before) == 0);
+				_codes.emplace_back(~std::uint64_t(0), 64);
+				_gammas.push_back(1);
+				_unaries.push_back(0);
+				_writer.write_gamma(1);
+				_writer.write_unary(0);
+				for (int i = 0; i < 3000; ++i) {
+					auto _n = size_t(rng() % 65);
+					auto _val = rng() & bit_stream_detail::low_mask(_n);
+					_writer.write(_val, _n);
+					_codes.emplace_back(_val, _n);
+					auto _gamma = (rng() >> (rng() % 64)) | 1;
+					_writer.write_gamma(_gamma);
+					_gammas.push_back(_gamma);
+					auto _unary = size_t(rng() % 150);
+					_writer.write_unary(_unary);
+					_unaries.push_back(_unary);
+				}
+				_writer.flush();
+				CHECK(_writer.size() == _bits.size());
+			}
+			bit_reader _reader(_bits);
+			for (size_t i = 0; i < _prefix; ++i) {
+				CHECK(_reader.read_bit() == (i % 3 == 0));
+			}
+			for (size_t i = 0; i < _codes.size(); ++i) {
+				CHECK(_reader.peek(_codes[i].second) == _codes[i].first);
+				CHECK(_reader.read(_codes[i].second) == _codes[i].first);
+				CHECK(_reader.read_gamma() == _gammas[i]);
+				CHECK(_reader.read_unary() == _unaries[i]);
+			}
+			CHECK(_reader.eof());
+		}
+	}
+
+	/*߽׷ӡСչ洢ת*/
+	void test_segmented() {
+		const auto _chunk = segmented_dynamic_bitset::chunk_bits();
+		for (size_t _n : { size_t(0), size_t(63), size_t(1000), _chunk - 1, _chunk, _chunk + 1, 2 * _chunk + 77 }) {
+			dynamic_bitset _plain;
+			_plain.resize(_n);
+			for (size_t i = 0; i < _plain.word_count(); ++i) {
+				_plain.set_word(i, rng());
+			}
+			segmented_dynamic_bitset _segmented(_plain);
+			CHECK(_segmented.size() == _n);
+			CHECK(_segmented.to_dynamic_bitset() == _plain);
+			CHECK(_segmented.count() == _plain.count());
+		}
+		segmented_dynamic_bitset _segmented;
+		dynamic_bitset _ref;
+		while (_segmented.size() < _chunk + 5000) {
+			switch (rng() % 3) {
+			case 0: {
+				bool _val = rng() & 1;
+				_segmented.push_back(_val);
+				_ref.push_back(_val);
+				break;
+			}
+			case 1: {
+				auto _n = size_t(rng() % 300);
+				bool _val = rng() & 1;
+				_segmented.push_back(_n, _val);
+				_ref.push_back(_n, _val);
+				break;
+			}
+			default: {
+				dynamic_bitset _block;
+				_block.resize(rng() % 2 ? (rng() % 4) * 64000 : rng() % 100000);
+				for (size_t i = 0; i < _block.word_count(); ++i) {
+					_block.set_word(i, rng());
+				}
+				_segmented.push_back(_block);
+				_ref.push_back(_block);
+				break;
+			}
+			}
+		}
+		CHECK(_segmented.to_dynamic_bitset() == _ref);
+		_segmented.resize(_chunk - 10);
+		_ref.resize(_chunk - 10);
+		_segmented.resize(_chunk + 100);
+		_ref.resize(_chunk + 100);
+		CHECK(_segmented.to_dynamic_bitset() == _ref);
+		dynamic_bitset _other;
+		_other.resize(_chunk / 2);
+		for (size_t i = 0; i < _other.word_count(); ++i) {
+			_other.set_word(i, rng());
+		}
+		segmented_dynamic_bitset _segmented_other(_other);
+		CHECK((_segmented & _segmented_other).to_dynamic_bitset() == (_ref & _other));
+		CHECK((_segmented ^ _segmented_other).to_dynamic_bitset() == (_ref ^ _other));
+		CHECK(_segmented.intersection_count(_segmented_other) == intersection_count(_ref, _other));
+	}
+
+	/*ļֱpopcountһ£mutate()ı䳤֮*/
+	void test_counted() {
+		counted_dynamic_bitset _counted(dynamic_bitset(random_bits(20000)));
+		for (int it = 0; it < 3000; ++it) {
+			switch (rng() % 8) {
+			case 0:
+				_counted.resize(rng() % 30000);
+				break;
+			case 1:
+				_counted.mutate().resize(rng() % 30000);
+				break;
+			case 2:
+				_counted ^= dynamic_bitset(random_bits(rng() % 10000));
+				break;
+			default:
+				if (_counted.size() > 0) {
+					_counted.set(rng() % _counted.size(), rng() & 1);
+				}
+				break;
+			}
+			CHECK(_counted.count() == _counted.get().count());
+		}
+	}
+
+	void test_bloom_filter() {
+		auto _filter = blocked_bloom_filter::for_capacity(10000, 0.01);
+		std::vector<std::uint64_t> _keys(10000);
+		for (auto& k : _keys) {
+			k = rng();
+		}
+		_filter.insert(_keys.data(), _keys.size());
+		std::unique_ptr<bool[]> _found(new bool[_keys.size()]);
+		_filter.contains(_keys.data(), _keys.size(), _found.get());
+		for (size_t i = 0; i < _keys.size(); ++i) {
+			CHECK(_found[i] && _filter.contains(_keys[i]));
+		}
+		size_t _false_positives = 0;
+		for (int i = 0; i < 100000; ++i) {
+			_false_positives += _filter.contains(rng());
+		}
+		CHECK(_false_positives < 3000);
+		blocked_bloom_filter _empty;
+		CHECK(!_empty.contains(_keys[0]));
+		bool _thrown = false;
+		try {
+			blocked_bloom_filter::for_capacity(100, 1.0);
+		}
+		catch (const std::invalid_argument&) {
+			_thrown = true;
+		}
+		CHECK(_thrown);
+	}
+
+	/*ԱȽstd::stringĽһ£Ǳпп*/
+	void test_fingerprints() {
+		for (size_t _bits : { 37, 64, 100, 300, 700 }) {
+			const size_t _n = 150;
+			std::vector<std::string> _refs;
+			fingerprint_collection _collection(_bits);
+			for (size_t i = 0; i < _n; ++i) {
+				/*һָǰһСĶ֤оܽĶ*/
+				auto _ref = i % 3 == 0 || _refs.empty() ? random_bits(_bits) : _refs.back();
+				_ref[rng() % _bits] ^= 1;
+				_refs.push_back(_ref);
+				_collection.push_back(dynamic_bitset(_ref));
+			}
+			auto _hamming = [&](const std::string& lhs, const std::string& rhs) {
+				std::uint32_t _res = 0;
+				for (size_t i = 0; i < _bits; ++i) {
+					_res += lhs[i] != rhs[i];
+				}
+				return _res;
+			};
+			auto _jaccard = [&](const std::string& lhs, const std::string& rhs) {
+				size_t _and = 0, _or = 0;
+				for (size_t i = 0; i < _bits; ++i) {
+					_and += lhs[i] == '1' && rhs[i] == '1';
+					_or += lhs[i] == '1' || rhs[i] == '1';
+				}
+				return _or == 0 ? 1.0 : double(_and) / double(_or);
+			};
+			auto _query_ref = random_bits(_bits);
+			dynamic_bitset _query(_query_ref);
+			for (unsigned _threads : { 1u, 3u }) {
+				std::vector<std::uint32_t> _distances(_n);
+				std::vector<double> _similarities(_n);
+				_collection.hamming_to_all(_query, _distances.data(), _threads);
+				_collection.jaccard_to_all(_query, _similarities.data(), _threads);
+				for (size_t i = 0; i < _n; ++i) {
+					CHECK(_distances[i] == _hamming(_query_ref, _refs[i]));
+					CHECK(std::fabs(_similarities[i] - _jaccard(_query_ref, _refs[i])) < 1e-12);
+				}
+				std::vector<fingerprint_collection::neighbor> _expected;
+				for (size_t i = 0; i < _n; ++i) {
+					_expected.push_back({ i, _hamming(_query_ref, _refs[i]) });
+				}
+				std::sort(_expected.begin(), _expected.end(), [](const fingerprint_collection::neighbor& lhs, const fingerprint_collection::neighbor& rhs) {
+					return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.index < rhs.index;
+					});
+				auto _nearest = _collection.nearest_hamming(_query, 7, _threads);
+				CHECK(_nearest.size() == 7);
+				for (size_t i = 0; i < _nearest.size() && i < _expected.size(); ++i) {
+					CHECK(_nearest[i].index == _expected[i].index && _nearest[i].distance == _expected[i].distance);
+				}
+				auto _max_distance = std::uint32_t(_bits / 8);
+				std::vector<fingerprint_collection::pair> _pairs;
+				for (size_t i = 0; i < _n; ++i) {
+					for (size_t j = i + 1; j < _n; ++j) {
+						auto _distance = _hamming(_refs[i], _refs[j]);
+						if (_distance <= _max_distance) {
+							_pairs.push_back({ i, j, _distance });
+						}
+					}
+				}
+				auto _found = _collection.pairs_within_hamming(_max_distance, _threads);
+				CHECK(!_pairs.empty() && _found.size() == _pairs.size());
+				for (size_t i = 0; i < _found.size() && i < _pairs.size(); ++i) {
+					CHECK(_found[i].first == _pairs[i].first && _found[i].second == _pairs[i].second && _found[i].distance == _pairs[i].distance);
+				}
+			}
+		}
+	}
+
+	void test_fingerprint_move() {
+		fingerprint_collection _a(100);
+		_a.push_back(dynamic_bitset(std::string(100, '1')));
+		fingerprint_collection _b(std::move(_a));
+		CHECK(_b.size() == 1 && _a.size() == 0 && _a.bits() == 100);
+		_a.push_back(dynamic_bitset(std::string(100, '0')));
+		CHECK(_a.size() == 1);
+	}
+
+#if defined DYNAMIC_BITSET_STATS
+	/*heap_spillsֻͳƴssoתѵĴmove_bitsİ˼bytes_moved*/
+	void test_stats() {
+		using stats = dynamic_bitset_stats;
+		stats::reset_thread();
+		{
+			dynamic_bitset _big, _heap;
+			_big.resize(10000);
+			_heap.resize(200);
+			_heap = _big;
+			dynamic_bitset _sso;
+			auto _snapshot = stats::thread_snapshot();
+			CHECK(_snapshot[stats::instances] == 3);
+			CHECK(_snapshot[stats::heap_spills] == 2);
+			CHECK(_snapshot[stats::growths] == 3);
+			CHECK(_snapshot[stats::allocations] == 3 && _snapshot[stats::deallocations] == 1);
+			stats::reset_thread();
+			dynamic_bitset _moved(std::move(_big));
+			_snapshot = stats::thread_snapshot();
+			CHECK(_snapshot[stats::instances] == 1 && _snapshot[stats::heap_spills] == 0 && _snapshot[stats::allocations] == 0);
+			stats::reset_thread();
+			_moved.insert(0, 8, true);
+			CHECK(stats::thread_snapshot()[stats::bytes_moved] >= 10000 / 8);
+			stats::reset_thread();
+			_moved.erase(0, 3);
+			CHECK(stats::thread_snapshot()[stats::bytes_moved] >= 10000 / 8);
+		}
+		/*ֻ_heap_movedжڴ棬ߵ_big_ssoͷ*/
+		CHECK(stats::thread_snapshot()[stats::deallocations] == 2);
+	}
+#endif
+}
+
+int main() {
+	test_equality();
+	test_copy_move_swap();
+	test_set_relations();
+	test_fixed<100>();
+	test_fixed<200>();
+	test_insert_erase();
+	test_n_way();
+	test_indices();
+	test_bit_matrix();
+	test_shared_detach();
+	test_bit_stream();
+	test_segmented();
+	test_counted();
+	test_bloom_filter();
+	test_fingerprints();
+	test_fingerprint_move();
+#if defined DYNAMIC_BITSET_STATS
+	test_stats();
+#endif
+	if (failures != 0) {
+		std::fprintf(stderr, "%zu checks failed\n", failures);
+		return 1;
+	}
+	std::printf("all tests passed\n");
+	return 0;
+}